@@ -0,0 +1,78 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include <vector>
+
+#include "benchmark.h"
+#include "hdlc/frame_pipe.h"
+#include "hdlc/random_frame_factory.h"
+#include "hdlc/serializer.h"
+
+using namespace hdlc;
+
+int main(void)
+{
+  for (const size_t length : {16, 64, 256, 1024, 4096})
+  {
+    std::vector<uint8_t> payload(length);
+    std::generate(payload.begin(), payload.end(), [] { return RandomFrameFactory::get_random_byte(); });
+
+    const Frame frame(payload, Frame::Type::I);
+    const auto  escaped = FrameSerializer::escape(FrameSerializer::serialize(frame));
+    const auto  runs    = (size_t(1) << 24) / length;
+    FramePipe   pipe(escaped.size() * 2);
+
+    std::vector<uint8_t> storage(escaped.size());
+
+    fmt::print("Frame with {} byte payload, {} bytes on the wire\n", length, escaped.size());
+
+    benchmark::report(benchmark::run("  encode: escape(serialize())", escaped.size(), runs, [&] {
+      const auto bytes = FrameSerializer::escape(FrameSerializer::serialize(frame));
+      pipe.write(bytes);
+      pipe.clear();
+    }));
+
+    benchmark::report(benchmark::run("  encode: write_frame(encode())", escaped.size(), runs, [&] {
+      pipe.write_frame([&](span<uint8_t> first, span<uint8_t> second) { return FrameSerializer::encode(frame, first, second); });
+      pipe.clear();
+    }));
+
+    benchmark::report(benchmark::run("  send: write_frame(encode(Frame(payload)))", escaped.size(), runs, [&] {
+      const Frame copy(payload, Frame::Type::I);
+      pipe.write_frame([&](span<uint8_t> first, span<uint8_t> second) { return FrameSerializer::encode(copy, first, second); });
+      pipe.clear();
+    }));
+
+    benchmark::report(benchmark::run("  send: write_frame(encode(header, {payload}))", escaped.size(), runs, [&] {
+      const FrameView           header(Frame::Type::I);
+      const span<const uint8_t> parts[] = {payload};
+      pipe.write_frame([&](span<uint8_t> first, span<uint8_t> second) { return FrameSerializer::encode(header, parts, first, second); });
+      pipe.clear();
+    }));
+
+    benchmark::report(benchmark::run("  decode: deserialize(descape(read_frame()))", escaped.size(), runs, [&] {
+      pipe.write(escaped);
+      benchmark::do_not_optimize(FrameSerializer::deserialize(FrameSerializer::descape(pipe.read_frame())));
+    }));
+
+    benchmark::report(benchmark::run("  decode: read_frame(decode())", escaped.size(), runs, [&] {
+      pipe.write(escaped);
+      pipe.read_frame([&](span<const uint8_t> first, span<const uint8_t> second) {
+        benchmark::do_not_optimize(FrameSerializer::decode(first, second));
+      });
+    }));
+
+    benchmark::report(benchmark::run("  decode: read_frame(decode_view())", escaped.size(), runs, [&] {
+      pipe.write(escaped);
+      pipe.read_frame([&](span<const uint8_t> first, span<const uint8_t> second) {
+        benchmark::do_not_optimize(FrameSerializer::decode_view(first, second, storage));
+      });
+    }));
+  }
+
+  return 0;
+}
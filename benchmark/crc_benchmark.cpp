@@ -0,0 +1,74 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include <vector>
+
+#include <boost/crc.hpp>
+
+#include "benchmark.h"
+#include "hdlc/crc.h"
+#include "hdlc/random_frame_factory.h"
+
+using namespace hdlc;
+
+int main(void)
+{
+  fmt::print("Active kernel: {}\n", crc::active_kernel() == crc::kernel::clmul ? "clmul" : "table");
+
+  for (const size_t length : {16, 64, 256, 1500, 4096, 65536})
+  {
+    std::vector<uint8_t> buffer(length);
+    const auto           begin  = buffer.data();
+    const auto           end    = buffer.data() + length;
+    const auto           runs   = (size_t(1) << 24) / length;
+    boost::crc_basic<16> reference(0x1021, 0xFFFF, 0, false, false);
+
+    std::generate(buffer.begin(), buffer.end(), [] { return RandomFrameFactory::get_random_byte(); });
+
+    fmt::print("CRC-16/CCITT, {} bytes\n", length);
+
+    benchmark::report(benchmark::run("  boost::crc_basic<16> (before)", length, runs, [&] {
+      reference.reset();
+      reference.process_bytes(begin, length);
+      benchmark::do_not_optimize(reference.checksum());
+    }));
+
+    benchmark::report(benchmark::run("  bytewise table", length, runs, [&] {
+      benchmark::do_not_optimize(crc::ccitt16::update_bytewise(crc::ccitt16::initial, begin, end));
+    }));
+
+    benchmark::report(benchmark::run("  slice-by-8", length, runs, [&] {
+      benchmark::do_not_optimize(crc::ccitt16::update_table(crc::ccitt16::initial, begin, end));
+    }));
+
+#if HDLC_USE_CLMUL
+    if (crc::detail::clmul_supported())
+    {
+      benchmark::report(benchmark::run("  clmul", length, runs, [&] {
+        benchmark::do_not_optimize(crc::detail::ccitt16_clmul(crc::ccitt16::initial, begin, end));
+      }));
+    }
+#endif
+
+    fmt::print("CRC-32, {} bytes\n", length);
+
+    benchmark::report(benchmark::run("  slice-by-8", length, runs, [&] {
+      benchmark::do_not_optimize(crc::crc32::update_table(crc::crc32::initial, begin, end));
+    }));
+
+#if HDLC_USE_CLMUL
+    if (crc::detail::clmul_supported())
+    {
+      benchmark::report(benchmark::run("  clmul", length, runs, [&] {
+        benchmark::do_not_optimize(crc::detail::crc32_clmul(crc::crc32::initial, begin, end));
+      }));
+    }
+#endif
+  }
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+
+#include <chrono>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#include <fmt/format.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HDLC_BENCHMARK_USE_TSC 1
+#else
+#define HDLC_BENCHMARK_USE_TSC 0
+#endif
+
+namespace hdlc
+{
+namespace benchmark
+{
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Returns a cycle count.
+ *
+ * @return     Time stamp counter on x86, nanoseconds elsewhere.
+ */
+inline uint64_t cycles(void)
+{
+#if HDLC_BENCHMARK_USE_TSC
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Result of a single benchmark.
+ */
+struct result
+{
+  std::string name;
+  size_t      bytes   = 0; //! Total number of bytes processed.
+  uint64_t    cycles  = 0; //! Total cycles elapsed.
+  double      seconds = 0; //! Total wall time elapsed.
+
+  double bytes_per_cycle() const { return cycles ? double(bytes) / double(cycles) : 0.0; }
+  double megabytes_per_second() const { return seconds > 0 ? double(bytes) / seconds / 1e6 : 0.0; }
+};
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Runs a function repeatedly and measures it.
+ *
+ * @param[in]  name        Name printed in the report
+ * @param[in]  bytes       Number of bytes processed by a single call
+ * @param[in]  iterations  Number of calls
+ * @param      func        The function to measure
+ *
+ * @tparam     func_t      Callable type
+ *
+ * @return     The result.
+ */
+template <typename func_t>
+result run(const std::string& name, const size_t bytes, const size_t iterations, func_t&& func)
+{
+  // Warm up caches and branch predictors before measuring.
+  for (size_t i = 0; i < (iterations >> 4) + 1; ++i) func();
+
+  const auto start_time   = std::chrono::steady_clock::now();
+  const auto start_cycles = cycles();
+  for (size_t i = 0; i < iterations; ++i) func();
+  const auto end_cycles = cycles();
+  const auto end_time   = std::chrono::steady_clock::now();
+
+  result r;
+  r.name    = name;
+  r.bytes   = bytes * iterations;
+  r.cycles  = end_cycles - start_cycles;
+  r.seconds = std::chrono::duration<double>(end_time - start_time).count();
+  return r;
+}
+
+inline void report(const result& r)
+{
+  fmt::print("{:<40} {:>10.3f} bytes/cycle {:>12.1f} MB/s\n", r.name, r.bytes_per_cycle(), r.megabytes_per_second());
+}
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Stops the compiler from optimising away a result.
+ */
+template <typename T>
+inline void do_not_optimize(const T& value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace benchmark
+} // namespace hdlc
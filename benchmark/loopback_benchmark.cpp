@@ -0,0 +1,126 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+#include <vector>
+
+#include "benchmark.h"
+#include "hdlc/io.h"
+#include "hdlc/pool.h"
+#include "hdlc/random_frame_factory.h"
+
+using namespace hdlc;
+
+// Counts global allocations so the report can show allocations per frame.
+static std::atomic<size_t> l_allocations(0);
+
+__attribute__((noinline)) void* operator new(size_t size)
+{
+  ++l_allocations;
+  if (void* ptr = malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* ptr) noexcept { free(ptr); }
+__attribute__((noinline)) void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+
+namespace
+{
+/**
+ * @brief      Loops the out pipe back into the in pipe on the calling thread.
+ */
+class loopback : public base_io
+{
+public:
+  loopback() : base_io(8192) {}
+
+  size_t get_tick(void) const override { return 0; }
+  bool   handle_out(void) override
+  {
+    uint8_t chunk[256];
+    while (m_out_pipe.empty() == false)
+    {
+      const auto count = m_out_pipe.read(span<uint8_t>(chunk));
+      m_in_pipe.write(chunk, chunk + count);
+    }
+    dispatch_frames();
+    return true;
+  }
+  bool handle_in(void) override { return true; }
+  void reset(void) override {}
+  void sleep(const size_t) override {}
+};
+} // namespace
+
+int main(void)
+{
+  loopback io;
+
+  for (const size_t length : {0, 16, 64, 256})
+  {
+    std::vector<uint8_t> payload(length);
+    std::generate(payload.begin(), payload.end(), [] { return RandomFrameFactory::get_random_byte(); });
+    const auto frame = length ? Frame(payload, Frame::Type::I) : Frame(Frame::Type::RR, true, 0x10, 3);
+
+    const auto runs   = size_t(1) << 16;
+    const auto before = l_allocations.load();
+    pool::reset_thread_statistics();
+    const auto result = benchmark::run(fmt::format("  {} byte payload", length), FrameSerializer::frame_min_size + length, runs, [&] {
+      Frame received;
+      io.send_frame(frame);
+      io.handle_out();
+      io.recieve_frame(received);
+      Frame copy = received;
+      benchmark::do_not_optimize(copy);
+    });
+    const auto allocations = l_allocations.load() - before;
+
+    // run() adds a warm up of runs / 16 + 1 calls.
+    benchmark::report(result);
+    const auto stats = pool::thread_statistics();
+    fmt::print("    {:.2f} allocations per frame, pool hits {} misses {} releases {}\n",
+               double(allocations) / double(runs + (runs >> 4) + 1), stats.hits, stats.misses, stats.releases);
+  }
+
+  fmt::print("Subscribed with on_frame(), no Frame is built\n");
+  for (const size_t length : {16, 256})
+  {
+    const Frame frame(std::vector<uint8_t>(length, 0x55), Frame::Type::I);
+    size_t      seen = 0;
+    io.on_frame([&seen](const FrameView& view) { seen += view.payload_size(); });
+
+    const auto runs   = size_t(1) << 16;
+    const auto before = l_allocations.load();
+    benchmark::report(benchmark::run(fmt::format("  {} byte payload", length), FrameSerializer::frame_min_size + length, runs, [&] {
+      io.send_frame(frame);
+      io.handle_out();
+    }));
+    fmt::print("    {:.2f} allocations per frame\n", double(l_allocations.load() - before) / double(runs + (runs >> 4) + 1));
+    benchmark::do_not_optimize(seen);
+    io.on_frame(nullptr);
+  }
+
+  fmt::print("Codec buffers, descape(escape(serialize()))\n");
+  for (const size_t length : {16, 256, 1024})
+  {
+    const Frame frame(std::vector<uint8_t>(length, 0x55), Frame::Type::I);
+    const auto  runs = (size_t(1) << 22) / length;
+
+    benchmark::report(benchmark::run(fmt::format("  {} bytes, std::allocator", length), length, runs, [&] {
+      benchmark::do_not_optimize(FrameSerializer::descape(FrameSerializer::escape(FrameSerializer::serialize(frame))));
+    }));
+    benchmark::report(benchmark::run(fmt::format("  {} bytes, pool::allocator", length), length, runs, [&] {
+      benchmark::do_not_optimize(
+          FrameSerializer::descape(FrameSerializer::escape(FrameSerializer::serialize<pool::allocator<uint8_t>>(frame))));
+    }));
+  }
+
+  return 0;
+}
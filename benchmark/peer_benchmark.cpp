@@ -0,0 +1,113 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+#include "hdlc/abm_session_peer.h"
+#include "hdlc/fd_io.h"
+
+#if HDLC_USE_EPOLL
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace hdlc;
+
+#if HDLC_USE_EPOLL
+namespace
+{
+using peer_type = session::abm::Peer<fd_io>;
+
+/**
+ * @brief      Runs a peer on its own thread and counts the payload bytes it
+ *             receives.
+ */
+struct running_peer
+{
+  running_peer(fd_io& io, const uint8_t local, const uint8_t remote) : peer(io, local, remote)
+  {
+    io.set_response_timeout(10);
+    peer.set_information_handler([this](const Frame& frame) { received += frame.payload_size(); });
+    thread = std::thread([this] {
+      while (!done) peer.run();
+    });
+  }
+  ~running_peer()
+  {
+    done = true;
+    thread.join();
+  }
+
+  peer_type           peer;
+  std::atomic<size_t> received{0};
+  std::atomic<bool>   done{false};
+  std::thread         thread;
+};
+
+/**
+ * @brief      Sends count payloads from a, and from b at the same time when
+ *             both is set, over a socket pair.
+ */
+void transfer(const size_t payload, const bool both)
+{
+  int sv[2];
+  if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0)
+    return;
+
+  reactor r;
+  fd_io   io_a(sv[0], 65536), io_b(sv[1], 65536);
+  r.add(io_a);
+  r.add(io_b);
+  std::thread t_reactor([&r] { r.run(); });
+  {
+    running_peer a(io_a, 0x01, 0x02), b(io_b, 0x02, 0x01);
+    if (a.peer.connect() == StatusError::Success)
+    {
+      constexpr size_t           count = 2000;
+      const std::vector<uint8_t> data(payload, 0x55);
+      const auto                 send_all = [&data](peer_type& peer) {
+        for (size_t i = 0; i < count; ++i) peer.send_payload(data);
+        peer.flush();
+      };
+
+      const auto name   = fmt::format("  {}, {} byte payload", both ? "both ways" : "one way", payload);
+      const auto result = benchmark::run(name, (both ? 2 : 1) * count * payload, 4, [&] {
+        std::thread sender;
+        if (both)
+          sender = std::thread([&] { send_all(b.peer); });
+        send_all(a.peer);
+        if (sender.joinable())
+          sender.join();
+      });
+      benchmark::report(result);
+      if (both)
+        fmt::print("    {:.1f} MB/s each way\n", result.megabytes_per_second() / 2);
+    }
+  }
+  r.stop();
+  t_reactor.join();
+  ::close(sv[0]);
+  ::close(sv[1]);
+}
+} // namespace
+#endif
+
+int main(void)
+{
+#if HDLC_USE_EPOLL
+  fmt::print("Balanced mode peers over a socket pair\n");
+  for (const size_t payload : {64, 256, 1024})
+  {
+    transfer(payload, false);
+    transfer(payload, true);
+  }
+#endif
+  return 0;
+}
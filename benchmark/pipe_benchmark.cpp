@@ -0,0 +1,122 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include <vector>
+
+#include "benchmark.h"
+#include "hdlc/frame_pipe.h"
+#include "hdlc/random_frame_factory.h"
+#include "hdlc/serializer.h"
+
+using namespace hdlc;
+
+namespace
+{
+/**
+ * @brief      Streams one frame at a time through a 4 KiB pipe, so every
+ *             few frames one straddles the end of the storage.
+ */
+template <typename pipe_t>
+void stream_frames(const char* name, const std::vector<uint8_t>& bytes)
+{
+  pipe_t     pipe(4096);
+  size_t     split = 0;
+  const auto runs  = (size_t(1) << 24) / bytes.size();
+
+  benchmark::report(benchmark::run(name, bytes.size(), runs, [&] {
+    pipe.write(bytes);
+    pipe.read_frame([&](span<const uint8_t> first, span<const uint8_t> second) {
+      split += second.empty() ? 0 : 1;
+      benchmark::do_not_optimize(FrameSerializer::decode(first, second));
+    });
+  }));
+  fmt::print("    {} frames split at the wrap\n", split);
+}
+} // namespace
+
+int main(void)
+{
+  // The cost per frame should not depend on how many frames are queued.
+  for (const size_t payload : {8, 256})
+  {
+    for (const size_t depth : {1, 16, 256, 4096})
+    {
+      std::vector<uint8_t> stream;
+      for (size_t i = 0; i < depth; ++i)
+      {
+        std::vector<uint8_t> data(payload);
+        std::generate(data.begin(), data.end(), [] { return RandomFrameFactory::get_random_byte(); });
+        const auto bytes = FrameSerializer::escape(FrameSerializer::serialize(Frame(data, Frame::Type::I)));
+        stream.insert(stream.end(), bytes.begin(), bytes.end());
+      }
+
+      FramePipe  pipe(stream.size());
+      const auto runs = (size_t(1) << 24) / stream.size() + 1;
+
+      fmt::print("{} frames of {} bytes queued, {} bytes\n", depth, payload, stream.size());
+
+      benchmark::report(benchmark::run("  write", stream.size(), runs, [&] {
+        pipe.write(stream);
+        pipe.clear();
+      }));
+
+      benchmark::report(benchmark::run("  write + read_frame()", stream.size(), runs, [&] {
+        pipe.write(stream);
+        while (pipe.frame_count())
+        {
+          benchmark::do_not_optimize(pipe.read_frame());
+        }
+      }));
+
+      benchmark::report(benchmark::run("  write + read_frame(decode)", stream.size(), runs, [&] {
+        pipe.write(stream);
+        while (pipe.read_frame([](span<const uint8_t> first, span<const uint8_t> second) {
+          benchmark::do_not_optimize(FrameSerializer::decode(first, second));
+        }))
+          ;
+      }));
+    }
+  }
+
+  // Moving raw bytes through a pipe, as a transport does.
+  {
+    std::vector<uint8_t> stream(4096);
+    std::generate(stream.begin(), stream.end(), [] { return RandomFrameFactory::get_random_byte(); });
+    std::vector<uint8_t> out(stream.size());
+    FramePipe            pipe(stream.size());
+    const auto           runs = (size_t(1) << 24) / stream.size();
+
+    fmt::print("Raw bytes, {} at a time\n", stream.size());
+
+    benchmark::report(benchmark::run("  byte write + byte read", stream.size(), runs, [&] {
+      for (const auto byte : stream) pipe.write(byte);
+      for (auto& byte : out) byte = pipe.read();
+      benchmark::do_not_optimize(out.data());
+    }));
+
+    benchmark::report(benchmark::run("  span write + span read", stream.size(), runs, [&] {
+      pipe.write(span<const uint8_t>(stream));
+      pipe.read(span<uint8_t>(out));
+      benchmark::do_not_optimize(out.data());
+    }));
+  }
+
+  for (const size_t payload : {64, 1000})
+  {
+    std::vector<uint8_t> data(payload);
+    std::generate(data.begin(), data.end(), [] { return RandomFrameFactory::get_random_byte(); });
+    const auto bytes = FrameSerializer::escape(FrameSerializer::serialize(Frame(data, Frame::Type::I)));
+
+    fmt::print("Frames of {} bytes streamed through the ring, write + read_frame(decode)\n", payload);
+    stream_frames<FramePipe>("  heap ring", bytes);
+#if HDLC_USE_MIRRORED_RING
+    stream_frames<MirroredFramePipe>("  mirrored ring", bytes);
+#endif
+  }
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "benchmark.h"
+#include "hdlc/fd_io.h"
+#include "hdlc/uring_io.h"
+
+#if HDLC_USE_EPOLL
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace hdlc;
+
+#if HDLC_USE_EPOLL
+namespace
+{
+/**
+ * @brief      Links constructed in place, the pipes are over aligned.
+ */
+template <size_t count, typename link_t>
+struct fd_links
+{
+  fd_links(const int* fds) : fd_links(fds, std::make_index_sequence<count>()) {}
+  template <size_t... index>
+  fd_links(const int* fds, std::index_sequence<index...>) : links{{{fds[index], 4096}...}}
+  {
+  }
+
+  std::array<link_t, count> links;
+};
+
+void report_calls(const reactor&, const size_t frames) { fmt::print("    {} frames\n", frames); }
+
+#if HDLC_USE_IO_URING
+void report_calls(const uring_reactor& r, const size_t frames)
+{
+  const auto stats = r.get_statistics();
+  fmt::print("    {} frames, {:.3f} io_uring_enter() per frame, {} requests\n", frames, double(stats.enters) / double(frames),
+             stats.submitted);
+}
+#endif
+
+/**
+ * @brief      Every link sends a frame to its peer, then the reactor runs on
+ *             this thread until all of them have arrived. Running the reactor
+ *             in line keeps the scheduler out of the batching.
+ */
+template <typename reactor_t, typename link_t, size_t pairs>
+void links(const char* name, const size_t payload)
+{
+  std::array<int, 2 * pairs> fds;
+  for (size_t i = 0; i < pairs; ++i) ::socketpair(AF_UNIX, SOCK_STREAM, 0, &fds[2 * i]);
+
+  reactor_t                   r;
+  fd_links<2 * pairs, link_t> set(fds.data());
+  size_t                      received = 0;
+  const Frame                 frame(std::vector<uint8_t>(payload, 0x55), Frame::Type::I);
+
+  for (auto& link : set.links)
+  {
+    link.on_frame([&received](const FrameView&) { ++received; });
+    r.add(link);
+  }
+
+  size_t expected = 0;
+  benchmark::report(benchmark::run(fmt::format("  {} {:>2} links, {} byte payload", name, 2 * pairs, payload),
+                                   2 * pairs * (FrameSerializer::frame_min_size + payload), 2000, [&] {
+                                     for (auto& link : set.links) link.send_frame(frame);
+                                     expected += set.links.size();
+                                     while (received < expected) r.run_once(-1);
+                                   }));
+
+  report_calls(r, expected);
+  for (auto& link : set.links) r.remove(link);
+  for (auto fd : fds) ::close(fd);
+}
+} // namespace
+#endif
+
+int main(void)
+{
+#if HDLC_USE_EPOLL
+  fmt::print("Reactor over socket pairs\n");
+  links<reactor, fd_io, 1>("epoll   ", 64);
+  links<reactor, fd_io, 4>("epoll   ", 64);
+  links<reactor, fd_io, 16>("epoll   ", 64);
+  links<reactor, fd_io, 16>("epoll   ", 512);
+#if HDLC_USE_IO_URING
+  if (uring_reactor().is_open())
+  {
+    fmt::print("  io_uring fixed buffers: {}\n", uring_reactor().fixed_buffers());
+    links<uring_reactor, uring_io, 1>("io_uring", 64);
+    links<uring_reactor, uring_io, 4>("io_uring", 64);
+    links<uring_reactor, uring_io, 16>("io_uring", 64);
+    links<uring_reactor, uring_io, 16>("io_uring", 512);
+  }
+#endif
+#endif
+  return 0;
+}
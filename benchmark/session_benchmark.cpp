@@ -0,0 +1,137 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+#include "hdlc/snrm_session_client.h"
+#include "hdlc/snrm_session_master.h"
+#include "link_io.h"
+
+using namespace hdlc;
+
+namespace
+{
+/**
+ * @brief      Flips bits of the frames crossing a link_io at the given bit
+ *             error rate.
+ */
+class bit_errors
+{
+public:
+  explicit bit_errors(const double ber) : m_gap(ber) { m_next_error = m_gap(m_random); }
+
+  bool operator()(std::vector<uint8_t>& bytes)
+  {
+    // Distance to the next flipped bit is geometric, it carries on
+    // into the next frame.
+    const auto bits = bytes.size() * 8;
+    for (; m_next_error < bits; m_next_error += m_gap(m_random) + 1) bytes[m_next_error / 8] ^= uint8_t(1u << (m_next_error % 8));
+    m_next_error -= bits;
+    return true;
+  }
+
+private:
+  std::geometric_distribution<size_t> m_gap;
+  std::mt19937                        m_random{1};
+  size_t                              m_next_error = 0; //! Bit of the next frame which is flipped.
+};
+
+/**
+ * @brief      How the master sends and the client receives.
+ */
+struct mode
+{
+  const char* name;
+  size_t      window;
+  bool        stop_and_wait; //! send_payload() each frame instead of queue_payload().
+  bool        selective;     //! Client holds frames after a gap and sends SREJ.
+  bool        extended;      //! Set up with SNRME, sequence numbers modulo 128.
+};
+
+/**
+ * @brief      Sends count payloads, either one at a time waiting for each
+ *             acknowledgement or through the window, and reports the
+ *             goodput.
+ */
+void transfer(const std::chrono::microseconds delay, const double ber, const mode& m)
+{
+  using client_type = session::snrm::Client<link_io::endpoint>;
+
+  link_io                                  link(delay, 32768); // Room for a full extended window.
+  session::snrm::Master<link_io::endpoint> master(link.a, 0x01, 0x02);
+  client_type                              client(link.b, 0x02, 0x01);
+  std::atomic<bool>                        done{false};
+  if (ber > 0)
+  {
+    // One error process for both directions, as on a shared channel.
+    auto errors = std::make_shared<bit_errors>(ber);
+    auto tamper = [errors](std::vector<uint8_t>& bytes) { return (*errors)(bytes); };
+    link.set_tamper(tamper, tamper);
+  }
+  master.set_extended(m.extended);
+  client.install_handler(Frame::Type::I, [](client_type&, const Frame&, Frame&) { return StatusError::Success; });
+  client.set_selective_reject(m.selective);
+  // A few round trips, a lost frame should not stall the link for long.
+  link.a.set_response_timeout(4 * 2 * delay.count() / 1000 + 5);
+  std::thread t_client([&] {
+    while (!done) client.run();
+  });
+
+  constexpr size_t           count = 508;
+  const std::vector<uint8_t> payload(128, 0x55);
+  size_t                     failed = 0;
+  for (size_t i = 0; i < 4 && !master.connected(); ++i) master.connect();
+  if (master.connected())
+  {
+    master.set_window(m.window);
+    const auto result = benchmark::run(m.name, count * payload.size(), 2, [&] {
+      for (size_t i = 0; i < count; ++i)
+      {
+        const auto ret = m.stop_and_wait ? master.send_payload(payload) : master.queue_payload(payload);
+        failed += (ret != StatusError::Success) && master.connect() != StatusError::Success;
+      }
+      failed += master.flush() != StatusError::Success;
+    });
+    fmt::print("{:<40} {:>10.1f} frames/s {:>12.1f} kB/s goodput", result.name, count * 2 / result.seconds, result.megabytes_per_second() * 1e3);
+    fmt::print(failed ? " ({} failed)\n" : "\n", failed);
+  }
+
+  // Wake the client with a frame for nobody.
+  done            = true;
+  const auto wake = FrameSerializer::escape(FrameSerializer::serialize(Frame(Frame::Type::UI, false, 0x7F)));
+  link.b.in_bytes(span<const uint8_t>(wake));
+  t_client.join();
+}
+} // namespace
+
+int main(void)
+{
+  const mode modes[] = {
+      {"  stop and wait", 1, true, false, false},
+      {"  go back N, window 4", 4, false, false, false},
+      {"  go back N, window 7", 7, false, false, false},
+      {"  selective reject, window 4", 4, false, true, false},
+      {"  extended go back N, window 127", 127, false, false, true},
+      {"  extended selective reject, window 64", 64, false, true, true},
+  };
+
+  for (const auto ber : {0.0, 1e-4})
+  {
+    for (const auto delay : {std::chrono::microseconds(1000), std::chrono::microseconds(5000)})
+    {
+      fmt::print("128 byte payloads, {} us each way, bit error rate {}\n", delay.count(), ber);
+      for (const auto& m : modes) transfer(delay, ber, m);
+    }
+  }
+  return 0;
+}
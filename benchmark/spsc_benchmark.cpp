@@ -0,0 +1,196 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include <array>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/circular_buffer.hpp>
+
+#include "benchmark.h"
+#include "hdlc/frame_pipe.h"
+#include "hdlc/random_frame_factory.h"
+
+using namespace hdlc;
+
+namespace
+{
+/**
+ * @brief      The byte path of the pipe before it owned its storage, a mutex
+ *             around boost::circular_buffer. Kept as the baseline.
+ */
+class circular_buffer_pipe
+{
+public:
+  explicit circular_buffer_pipe(const size_t size) : m_buffer(size) {}
+
+  bool full() const
+  {
+    std::lock_guard<std::mutex> _l(m_mutex);
+    return m_buffer.full();
+  }
+
+  bool empty() const
+  {
+    std::lock_guard<std::mutex> _l(m_mutex);
+    return m_buffer.empty();
+  }
+
+  size_t space() const
+  {
+    std::lock_guard<std::mutex> _l(m_mutex);
+    return m_buffer.capacity() - m_buffer.size();
+  }
+
+  uint8_t read(void)
+  {
+    if (empty())
+      return 0;
+
+    std::lock_guard<std::mutex> _l(m_mutex);
+    const auto                  byte = m_buffer.front();
+    if (byte == protocol_bytes::frame_boundary)
+      --m_boundary_count;
+    m_buffer.pop_front();
+    return byte;
+  }
+
+  size_t read(span<uint8_t> out)
+  {
+    std::lock_guard<std::mutex> _l(m_mutex);
+    const auto                  count = std::min(out.size(), m_buffer.size());
+    std::copy_n(m_buffer.begin(), count, out.begin());
+    m_boundary_count -= std::count(m_buffer.begin(), m_buffer.begin() + count, protocol_bytes::frame_boundary);
+    m_buffer.erase_begin(count);
+    return count;
+  }
+
+  void write(const uint8_t byte)
+  {
+    if (full() == false)
+    {
+      std::lock_guard<std::mutex> _l(m_mutex);
+      if (byte == protocol_bytes::frame_boundary)
+        ++m_boundary_count;
+      m_buffer.push_back(byte);
+    }
+  }
+
+  template <typename iter_t>
+  void write(iter_t begin, iter_t end)
+  {
+    if (static_cast<size_t>(end - begin) > space())
+      return;
+
+    std::lock_guard<std::mutex> _l(m_mutex);
+    m_boundary_count += std::count(begin, end, protocol_bytes::frame_boundary);
+    m_buffer.insert(m_buffer.end(), begin, end);
+  }
+
+private:
+  mutable std::mutex              m_mutex;
+  size_t                          m_boundary_count = 0;
+  boost::circular_buffer<uint8_t> m_buffer;
+};
+
+constexpr size_t pipe_size = 4096;
+
+/**
+ * @brief      Moves the stream through the pipe one byte at a time on the
+ *             calling thread.
+ */
+template <typename pipe_t>
+void bytes_one_thread(pipe_t& pipe, const std::vector<uint8_t>& stream)
+{
+  for (size_t i = 0; i < stream.size(); i += pipe_size)
+  {
+    const auto count = std::min(pipe_size, stream.size() - i);
+    for (size_t j = 0; j < count; ++j)
+    {
+      if (!pipe.full())
+        pipe.write(stream[i + j]);
+    }
+    while (!pipe.empty())
+    {
+      benchmark::do_not_optimize(pipe.read());
+    }
+  }
+}
+
+/**
+ * @brief      Same with bulk writes and reads.
+ */
+template <typename pipe_t>
+void bulk_one_thread(pipe_t& pipe, const std::vector<uint8_t>& stream)
+{
+  std::array<uint8_t, 256> out;
+  for (size_t i = 0; i < stream.size(); i += out.size())
+  {
+    const auto count = std::min(out.size(), stream.size() - i);
+    pipe.write(stream.begin() + i, stream.begin() + i + count);
+    benchmark::do_not_optimize(pipe.read(span<uint8_t>(out)));
+  }
+}
+
+/**
+ * @brief      An io thread writes the stream one byte at a time while this
+ *             thread reads it, the way the example io moves data.
+ */
+template <typename pipe_t>
+void bytes_two_threads(pipe_t& pipe, const std::vector<uint8_t>& stream)
+{
+  std::thread producer([&] {
+    for (const auto byte : stream)
+    {
+      while (pipe.full())
+        std::this_thread::yield();
+      pipe.write(byte);
+    }
+  });
+
+  for (size_t received = 0; received < stream.size();)
+  {
+    if (pipe.empty())
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    benchmark::do_not_optimize(pipe.read());
+    ++received;
+  }
+
+  producer.join();
+}
+} // namespace
+
+int main(void)
+{
+  std::vector<uint8_t> stream(size_t(1) << 22);
+  std::generate(stream.begin(), stream.end(), [] { return RandomFrameFactory::get_random_byte(); });
+
+  circular_buffer_pipe baseline(pipe_size);
+  FramePipe            locked(pipe_size);
+  SpscFramePipe        lock_free(pipe_size);
+
+  fmt::print("Byte at a time, one thread\n");
+  benchmark::report(benchmark::run("  mutex + boost::circular_buffer (before)", stream.size(), 4, [&] { bytes_one_thread(baseline, stream); }));
+  benchmark::report(benchmark::run("  FramePipe (mutex)", stream.size(), 4, [&] { bytes_one_thread(locked, stream); }));
+  benchmark::report(benchmark::run("  SpscFramePipe", stream.size(), 4, [&] { bytes_one_thread(lock_free, stream); }));
+
+  fmt::print("Bulk 256 bytes, one thread\n");
+  benchmark::report(benchmark::run("  mutex + boost::circular_buffer (before)", stream.size(), 4, [&] { bulk_one_thread(baseline, stream); }));
+  benchmark::report(benchmark::run("  FramePipe (mutex)", stream.size(), 4, [&] { bulk_one_thread(locked, stream); }));
+  benchmark::report(benchmark::run("  SpscFramePipe", stream.size(), 4, [&] { bulk_one_thread(lock_free, stream); }));
+
+  fmt::print("Byte at a time, producer and consumer threads ({} hardware threads)\n", std::thread::hardware_concurrency());
+  benchmark::report(benchmark::run("  mutex + boost::circular_buffer (before)", stream.size(), 1, [&] { bytes_two_threads(baseline, stream); }));
+  benchmark::report(benchmark::run("  FramePipe (mutex)", stream.size(), 1, [&] { bytes_two_threads(locked, stream); }));
+  benchmark::report(benchmark::run("  SpscFramePipe", stream.size(), 1, [&] { bytes_two_threads(lock_free, stream); }));
+
+  return 0;
+}
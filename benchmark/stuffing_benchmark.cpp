@@ -0,0 +1,134 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include <vector>
+
+#include "benchmark.h"
+#include "hdlc/random_frame_factory.h"
+#include "hdlc/serializer.h"
+#include "hdlc/stuffing.h"
+
+using namespace hdlc;
+
+namespace
+{
+/**
+ * @brief      The byte at a time escape() this library used before the vector
+ *             kernels, kept as the baseline.
+ */
+std::vector<uint8_t> escape_bytewise(const std::vector<uint8_t>& frame)
+{
+  const auto extra_size = std::count_if(frame.begin() + 1, frame.end() - 1, [](const auto byte) { return stuffing::is_special(byte); });
+
+  std::vector<uint8_t> escaped;
+  escaped.reserve(frame.size() + extra_size);
+  escaped.emplace_back(protocol_bytes::frame_boundary);
+  for_each(frame.begin() + 1, frame.end() - 1, [&](const auto byte) {
+    switch (byte)
+    {
+    case protocol_bytes::frame_boundary:
+    case protocol_bytes::escape:
+      escaped.emplace_back(protocol_bytes::escape);
+      escaped.emplace_back(byte ^ (uint8_t)header_bits::stuffing);
+      break;
+    default: escaped.emplace_back(byte); break;
+    }
+  });
+  escaped.emplace_back(protocol_bytes::frame_boundary);
+  return escaped;
+}
+
+/**
+ * @brief      The byte at a time descape() baseline.
+ */
+std::vector<uint8_t> descape_bytewise(const std::vector<uint8_t>& buffer)
+{
+  const auto escaped = std::count(buffer.begin(), buffer.end(), protocol_bytes::escape);
+
+  std::vector<uint8_t> descaped;
+  descaped.reserve(buffer.size() - escaped);
+  bool pending = false;
+  for_each(buffer.begin(), buffer.end(), [&](const auto byte) {
+    if (pending)
+    {
+      descaped.emplace_back(byte ^ (uint8_t)header_bits::stuffing);
+      pending = false;
+    }
+    else if (byte == protocol_bytes::escape)
+    {
+      pending = true;
+    }
+    else
+    {
+      descaped.emplace_back(byte);
+    }
+  });
+  return descaped;
+}
+
+const char* kernel_name(const stuffing::kernel k)
+{
+  switch (k)
+  {
+  case stuffing::kernel::avx2: return "avx2";
+  case stuffing::kernel::sse2: return "sse2";
+  default: return "scalar";
+  }
+}
+} // namespace
+
+int main(void)
+{
+  fmt::print("Active kernel: {}\n", kernel_name(stuffing::active_kernel()));
+
+  for (const size_t length : {64, 1500, 4096})
+  {
+    // Percentage of bytes which have to be escaped.
+    for (const size_t density : {0, 1, 50})
+    {
+      std::vector<uint8_t> frame(length + 2);
+      std::generate(frame.begin(), frame.end(), [&] {
+        if (RandomFrameFactory::get_random(0, 99) < density)
+          return (RandomFrameFactory::get_random_byte() & 1) ? uint8_t(protocol_bytes::frame_boundary) : uint8_t(protocol_bytes::escape);
+        return static_cast<uint8_t>(RandomFrameFactory::get_random_byte() & 0x7B);
+      });
+      frame.front() = protocol_bytes::frame_boundary;
+      frame.back()  = protocol_bytes::frame_boundary;
+
+      const auto escaped = FrameSerializer::escape(frame);
+      const auto begin   = frame.data() + 1;
+      const auto end     = frame.data() + frame.size() - 1;
+      const auto runs    = (size_t(1) << 24) / length;
+
+      fmt::print("{} bytes, {}% escaped\n", length, density);
+
+      benchmark::report(benchmark::run("  escape bytewise (before)", length, runs, [&] { benchmark::do_not_optimize(escape_bytewise(frame)); }));
+      benchmark::report(benchmark::run("  escape", length, runs, [&] { benchmark::do_not_optimize(FrameSerializer::escape(frame)); }));
+      benchmark::report(benchmark::run("  descape bytewise (before)", escaped.size(), runs, [&] {
+        benchmark::do_not_optimize(descape_bytewise(escaped));
+      }));
+      benchmark::report(benchmark::run("  descape", escaped.size(), runs, [&] { benchmark::do_not_optimize(FrameSerializer::descape(escaped)); }));
+
+      benchmark::report(benchmark::run("  count_special scalar", length, runs, [&] {
+        benchmark::do_not_optimize(stuffing::count_special_scalar(begin, end));
+      }));
+#if HDLC_USE_X86_SIMD
+      benchmark::report(benchmark::run("  count_special sse2", length, runs, [&] {
+        benchmark::do_not_optimize(stuffing::detail::count_special_sse2(begin, end));
+      }));
+      if (stuffing::detail::avx2_supported())
+      {
+        benchmark::report(benchmark::run("  count_special avx2", length, runs, [&] {
+          benchmark::do_not_optimize(stuffing::detail::count_special_avx2(begin, end));
+        }));
+      }
+#endif
+    }
+  }
+
+  return 0;
+}
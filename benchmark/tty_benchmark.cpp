@@ -0,0 +1,152 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "hdlc/tty_io.h"
+
+#if HDLC_USE_EPOLL
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace hdlc;
+
+#if HDLC_USE_EPOLL
+namespace
+{
+constexpr double uart_bytes_per_second = 921600.0 / 10.0; //! 8N1 at 921600 baud.
+
+/**
+ * @brief      Runs a benchmark and also reports the CPU time it took per
+ *             byte, and the share of a core needed to keep up with the UART.
+ */
+template <typename func_t>
+void run(const std::string& name, const size_t bytes, const size_t iterations, func_t&& func)
+{
+  const auto start  = std::clock();
+  const auto result = benchmark::run(name, bytes, iterations, func);
+  const auto cpu    = double(std::clock() - start) / CLOCKS_PER_SEC;
+  // benchmark::run() warms up with iterations / 16 + 1 extra calls.
+  const auto total = double(bytes) * double(iterations + (iterations >> 4) + 1);
+
+  benchmark::report(result);
+  fmt::print("    {:.1f} ns CPU per byte, {:.2f}% of a core at 921600 baud\n", cpu / total * 1e9, cpu / total * uart_bytes_per_second * 100.0);
+}
+
+/**
+ * @brief      Opens a pty, the master stands in for the far end.
+ */
+int open_master(std::string& path)
+{
+  const int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || ::grantpt(master) < 0 || ::unlockpt(master) < 0)
+    return -1;
+  path = ::ptsname(master);
+  return master;
+}
+
+/**
+ * @brief      A frame at a time in both directions through the reactor,
+ *             bytes move in chunks between the pipes and the terminal.
+ */
+void chunked(const size_t payload)
+{
+  std::string path;
+  const int   master = open_master(path);
+  if (master < 0)
+    return;
+
+  tty::settings s;
+  s.baud = 921600;
+  {
+    reactor     r;
+    tty_io      port(path.c_str(), s);
+    fd_io       remote(master, 4096);
+    size_t      received = 0;
+    const Frame frame(std::vector<uint8_t>(payload, 0x55), Frame::Type::I);
+
+    port.on_frame([&received](const FrameView&) { ++received; });
+    remote.on_frame([&remote, &frame](const FrameView&) { remote.send_frame(frame); });
+    r.add(port);
+    r.add(remote);
+
+    size_t expected = 0;
+    run(fmt::format("  chunked, {} byte payload", payload), 2 * (FrameSerializer::frame_min_size + payload), 1000, [&] {
+      port.send_frame(frame);
+      ++expected;
+      while (received < expected) r.run_once(-1);
+    });
+  }
+  ::close(master);
+}
+
+/**
+ * @brief      The same exchange moving one byte per system call, as a
+ *             serial port driven through read(&byte, 1) and write(&byte, 1).
+ */
+void bytewise(const size_t payload)
+{
+  std::string path;
+  const int   master = open_master(path);
+  if (master < 0)
+    return;
+
+  tty::settings s;
+  s.baud = 921600;
+  {
+    tty_io      port(path.c_str(), s);
+    fd_io       remote(master, 4096);
+    const Frame frame(std::vector<uint8_t>(payload, 0x55), Frame::Type::I);
+
+    // Writes everything queued in from, then reads into to until a frame
+    // has arrived.
+    const auto transfer = [](base_io& from, const int from_fd, base_io& to, const int to_fd) {
+      uint8_t byte;
+      while (from.out_byte(byte))
+      {
+        while (::write(from_fd, &byte, 1) < 0 && errno == EAGAIN)
+        {
+        }
+      }
+      while (to.in_frame_count() == 0)
+      {
+        if (::read(to_fd, &byte, 1) == 1)
+          to.in_byte(byte);
+      }
+    };
+
+    run(fmt::format("  bytewise, {} byte payload", payload), 2 * (FrameSerializer::frame_min_size + payload), 1000, [&] {
+      Frame rx;
+      port.send_frame(frame);
+      transfer(port, port.native_handle(), remote, master);
+      remote.recieve_frame(rx);
+      remote.send_frame(frame);
+      transfer(remote, master, port, port.native_handle());
+      port.recieve_frame(rx);
+    });
+  }
+  ::close(master);
+}
+} // namespace
+#endif
+
+int main(void)
+{
+#if HDLC_USE_EPOLL
+  fmt::print("Frames both ways over a pseudo terminal, 921600 baud carries {:.0f} bytes/s\n", uart_bytes_per_second);
+  bytewise(64);
+  chunked(64);
+  bytewise(1000);
+  chunked(1000);
+#endif
+  return 0;
+}
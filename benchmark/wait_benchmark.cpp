@@ -0,0 +1,112 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include <chrono>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+#include "hdlc/frame_pipe.h"
+#include "hdlc/serializer.h"
+
+using namespace hdlc;
+
+namespace
+{
+using clock = std::chrono::steady_clock;
+
+/**
+ * @brief      Waits for a frame by polling, the way recieve_frame used to.
+ */
+template <typename pipe_t>
+void poll_for_frame(pipe_t& pipe)
+{
+  while (pipe.frame_count() == 0)
+  {
+    // A single core needs the yield to let the other side run at all.
+    std::this_thread::yield();
+  }
+}
+
+template <typename pipe_t>
+void block_for_frame(pipe_t& pipe)
+{
+  while (!pipe.wait_for_frame(1000))
+  {
+  }
+}
+
+/**
+ * @brief      Bounces a frame between two threads and reports the average
+ *             one way latency.
+ */
+template <typename pipe_t, typename wait_t>
+void ping_pong(const char* name, const std::vector<uint8_t>& frame, wait_t&& wait)
+{
+  constexpr size_t rounds = 20000;
+  pipe_t           ping(1024), pong(1024);
+
+  std::thread echo([&] {
+    for (size_t i = 0; i < rounds; ++i)
+    {
+      wait(ping);
+      pong.write(ping.read_frame());
+    }
+  });
+
+  const auto start = clock::now();
+  for (size_t i = 0; i < rounds; ++i)
+  {
+    ping.write(frame);
+    wait(pong);
+    pong.read_frame();
+  }
+  const auto elapsed = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+  echo.join();
+
+  fmt::print("  {:<40} {:>8.2f} us per wake up\n", name, elapsed / (2 * rounds));
+}
+
+/**
+ * @brief      Reports the CPU used by a thread waiting on an idle pipe.
+ */
+template <typename pipe_t, typename wait_t>
+void idle(const char* name, const std::vector<uint8_t>& frame, wait_t&& wait)
+{
+  pipe_t pipe(1024);
+
+  std::thread late([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    pipe.write(frame);
+  });
+
+  const auto cpu_start = std::clock();
+  wait(pipe);
+  const auto cpu = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+  late.join();
+
+  fmt::print("  {:<40} {:>8.1f} ms CPU over 200 ms idle\n", name, cpu * 1e3);
+}
+} // namespace
+
+int main(void)
+{
+  const auto frame = FrameSerializer::escape(FrameSerializer::serialize(Frame(std::vector<uint8_t>(32, 0x55), Frame::Type::I)));
+
+  fmt::print("Wake up latency, {} hardware threads\n", std::thread::hardware_concurrency());
+  ping_pong<FramePipe>("FramePipe, polling", frame, [](FramePipe& p) { poll_for_frame(p); });
+  ping_pong<FramePipe>("FramePipe, wait_for_frame()", frame, [](FramePipe& p) { block_for_frame(p); });
+  ping_pong<SpscFramePipe>("SpscFramePipe, polling", frame, [](SpscFramePipe& p) { poll_for_frame(p); });
+  ping_pong<SpscFramePipe>("SpscFramePipe, wait_for_frame()", frame, [](SpscFramePipe& p) { block_for_frame(p); });
+
+  fmt::print("Idle link\n");
+  idle<FramePipe>("FramePipe, polling", frame, [](FramePipe& p) { poll_for_frame(p); });
+  idle<FramePipe>("FramePipe, wait_for_frame()", frame, [](FramePipe& p) { block_for_frame(p); });
+
+  return 0;
+}
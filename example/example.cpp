@@ -67,30 +67,36 @@ int run_sender(std::shared_ptr<serial::Serial> port)
 
 int run_listener(std::shared_ptr<serial::Serial> port, bool echo)
 {
-  example_io io(port); // create io port.
+  std::mutex              quit_mutex;
+  std::condition_variable quit_cv;
+  bool                    quit = false;
+  example_io              io(port); // create io port, declared last so its threads stop first.
+
+  // Frames are handled on the io thread as soon as they arrive.
+  io.on_frame([&](const FrameView& f) {
+    if (echo)
+    {
+      const span<const uint8_t> payload[] = {f.get_payload()};
+      io.send_frame(f, payload);
+    }
 
-  // auto io = std::make_shared
-  for (;;)
-  {
-    if (io.in_frame_count())
+    m_log->info("Recieved: {}", Frame(f));
+    if (f.has_payload())
     {
-      Frame f;
-      if (io.recieve_frame(f))
+      std::string payload(f.begin(), f.end());
+      m_log->info("Payload: {}", payload);
+      if ("quit" == payload)
       {
-        if (echo)
-          io.send_frame(f);
-
-        m_log->info("Recieved: {}", f);
-        if (f.has_payload())
-        {
-          std::string payload(f.begin(), f.end());
-          m_log->info("Payload: {}", payload);
-          if ("quit" == payload)
-            return 0;
-        }
+        std::lock_guard<std::mutex> lock(quit_mutex);
+        quit = true;
+        quit_cv.notify_all();
       }
     }
-  }
+  });
+
+  std::unique_lock<std::mutex> lock(quit_mutex);
+  quit_cv.wait(lock, [&] { return quit; });
+  return 0;
 }
 
 int run_normal_master(std::shared_ptr<serial::Serial> port, const uint8_t this_address, const uint8_t target_address)
@@ -70,24 +70,31 @@ public:
   }
   bool handle_out(void) override
   {
-    bool success = true;
-    while (m_out_pipe.empty() == false && success)
-    {
-      auto byte = m_out_pipe.read();
-      success   = (bool)m_ptr->write(&byte, 1);
-    }
-    return success;
+    const auto data = m_out_pipe.readable_regions();
+    if (data.size() == 0)
+      return true;
+
+    // Both halves of the ring are written in place, no byte at a time copy.
+    auto written = m_ptr->write(data.first.data(), data.first.size());
+    if (written == data.first.size() && data.second.empty() == false)
+      written += m_ptr->write(data.second.data(), data.second.size());
+    m_out_pipe.consume(written);
+    return written == data.size();
   }
   bool handle_in(void) override
   {
     const auto readable = m_ptr->waitReadable();
     if (readable)
     {
-      uint8_t byte;
-      while (m_in_pipe.full() == false && m_ptr->read(&byte, 1))
-      {
-        m_in_pipe.write(byte);
-      }
+      // Read whatever the driver holds straight into the free space of the
+      // in pipe, waitReadable() guarantees at least one byte.
+      const auto space = m_in_pipe.writable_regions();
+      auto       count = std::min(std::max<size_t>(m_ptr->available(), 1), space.size());
+      auto       read  = m_ptr->read(space.first.data(), std::min(count, space.first.size()));
+      if (read == space.first.size() && count > read)
+        read += m_ptr->read(space.second.data(), count - read);
+      m_in_pipe.commit(read);
+      dispatch_frames();
     }
     return readable;
   }
@@ -102,10 +109,10 @@ public:
 
 private:
   std::shared_ptr<serial::Serial> m_ptr;
+  mutable std::mutex              m_end_of_program_mutex; //! Declared before the threads so it is initialised before they start.
+  bool                            m_end_of_program = false;
   std::thread                     t_rx;
   std::thread                     t_tx;
-  mutable std::mutex              m_end_of_program_mutex;
-  bool                            m_end_of_program = false;
 
   bool is_done() const
   {
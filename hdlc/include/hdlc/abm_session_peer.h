@@ -0,0 +1,608 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+#include "frame.h"
+#include "frame_pipe.h"
+#include "io.h"
+#include "types.h"
+#include "windowed_session.h"
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace hdlc
+{
+namespace session
+{
+namespace abm
+{
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Session in asynchronous balanced mode, both ends are combined
+ *             stations which may send at any time.
+ *
+ * @tparam     io_t  IO type
+ *
+ * @details    The link is set up with SABM and UA from either end.
+ *             Information frames carry the N(R) of the other direction so
+ *             a busy link needs no supervisory frames. When there is
+ *             nothing to send received frames are acknowledged with RR
+ *             once the in pipe is empty. A frame out of sequence is
+ *             answered with REJ and the sender goes back to it (go back
+ *             N). If frames stay unacknowledged for retransmit_timeout()
+ *             the other end is polled with RR. If the final answer leaves
+ *             frames sent before the poll unacknowledged the sender goes
+ *             back to them, max_retries polls without an answer drop the
+ *             link.
+ *
+ *             With set_extended() the link is set up with SABME instead,
+ *             the control field is two bytes and up to 127 frames may be in
+ *             flight. A SABME from the other end switches this end too.
+ *
+ *             Commands carry the address of the other end, responses the
+ *             address of the end sending them.
+ *
+ *             Nothing waits for room in the out pipe. Frames which do not
+ *             fit are kept, information frames in the window and others in
+ *             a short queue, and run() sends them in order once there is
+ *             room.
+ *
+ *             run() must be called in a loop on its own thread, it receives
+ *             every frame and drives the timers. The other calls may be made
+ *             from any thread. The information handler is called on the
+ *             run() thread without any lock held, it must not wait for
+ *             acknowledgements.
+ */
+template <typename io_t>
+class Peer : public WindowedSession
+{
+public:
+  using information_handler = std::function<void(const Frame&)>; //! Called with each information frame received in sequence.
+  using mutex_type          = mutex_sync::mutex_type;
+  using lock_type           = std::lock_guard<mutex_type>;
+
+  static constexpr size_t max_retries = 3; //! Polls without an answer before the link is dropped.
+  static constexpr size_t max_pending = 8; //! Frames other than information kept while the out pipe is full.
+
+  /**
+   * @param      io      The io
+   * @param[in]  local   Address of this end
+   * @param[in]  remote  Address of the other end
+   */
+  Peer(io_t& io, const uint8_t local, const uint8_t remote) : WindowedSession(local, remote), m_io(io) {}
+  virtual ~Peer() {}
+
+  uint8_t local(void) const noexcept { return primary(); }
+  uint8_t remote(void) const noexcept { return secondary(); }
+
+  bool connected(void) const
+  {
+    lock_type lock(m_mutex);
+    return Session::connected();
+  }
+
+  void set_information_handler(information_handler handler) { m_information_handler = std::move(handler); }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Sets the number of frames which may be in flight.
+   *
+   * @param[in]  window  Clamped to [1, extended_modulus - 1], and further to
+   *                     modulus() - 1 of the link.
+   */
+  void set_window(const size_t window)
+  {
+    lock_type lock(m_mutex);
+    WindowedSession::set_window(window);
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Limits the bytes of information frames in flight.
+   *
+   * @param[in]  bytes  0, the default, for no limit. Set it to the capacity
+   *                    of the other end's in pipe, less room for a few
+   *                    supervisory frames.
+   */
+  void set_window_bytes(const size_t bytes)
+  {
+    lock_type lock(m_mutex);
+    WindowedSession::set_window_bytes(bytes);
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Sets up the link with SABME instead of SABM on the next
+   *             connect(), for sequence numbers modulo 128.
+   */
+  void set_extended(const bool extended)
+  {
+    lock_type lock(m_mutex);
+    m_extended = extended;
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Sets how long frames may stay unacknowledged before the
+   *             other end is polled, in ticks.
+   *
+   * @details    run() only returns once the io's response timeout passes
+   *             without a frame, keep that shorter.
+   */
+  void set_retransmit_timeout(const size_t timeout)
+  {
+    lock_type lock(m_mutex);
+    m_retransmit_timeout = timeout;
+  }
+  size_t retransmit_timeout(void) const
+  {
+    lock_type lock(m_mutex);
+    return m_retransmit_timeout;
+  }
+
+  /**
+   * @brief      Number of frames sent but not yet acknowledged.
+   */
+  size_t outstanding(void) const
+  {
+    lock_type lock(m_mutex);
+    return WindowedSession::outstanding();
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Sets up the link with SABM, retried max_retries times.
+   *
+   * @return     Status
+   */
+  StatusError connect(void)
+  {
+    for (size_t attempt = 0; attempt <= max_retries; ++attempt)
+    {
+      {
+        lock_type lock(m_mutex);
+        if (Session::connected())
+          return StatusError::Success;
+        set_status(ConnectionStatus::Connecting);
+        if (!send(Frame(m_extended ? Frame::Type::SABME : Frame::Type::SABM, true, remote())))
+          return StatusError::FailedToSend;
+      }
+      if (m_changed.wait_for(retransmit_timeout(), [this] { return connected(); }))
+        return StatusError::Success;
+    }
+    lock_type lock(m_mutex);
+    if (Session::connected())
+      return StatusError::Success;
+    disconnect();
+    return StatusError::NoResponse;
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Takes the link down with DISC.
+   */
+  void close(void)
+  {
+    {
+      lock_type lock(m_mutex);
+      if (Session::connected())
+        send(Frame(Frame::Type::DISC_RD, true, remote()));
+      drop();
+    }
+    m_changed.notify();
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Sends a payload without waiting for it to be acknowledged.
+   *
+   * @return     StatusError::Busy if the window is full, the frame is not
+   *             sent then.
+   */
+  template <typename buffer_t>
+  StatusError queue_payload(const buffer_t& buffer)
+  {
+    auto      entry = make_entry(buffer);
+    lock_type lock(m_mutex);
+    return queue(entry);
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Sends a payload, waiting while the window is full.
+   *
+   * @return     Status
+   */
+  template <typename buffer_t>
+  StatusError send_payload(const buffer_t& buffer)
+  {
+    auto entry = make_entry(buffer);
+    for (;;)
+    {
+      {
+        lock_type  lock(m_mutex);
+        const auto ret = queue(entry);
+        if (ret != StatusError::Busy)
+          return ret;
+      }
+      wait([this, &entry] { return has_room(window(), entry.bytes); });
+    }
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Waits until everything sent has been acknowledged.
+   */
+  StatusError flush(void)
+  {
+    wait([this] { return m_ack_seq == m_send_seq; });
+    return connected() ? StatusError::Success : StatusError::ConnectionError;
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Receives and handles one frame, then runs the timers.
+   *
+   * @return     The connection status.
+   */
+  ConnectionStatus run(void)
+  {
+    size_t idle;
+    {
+      // Frames waiting for the out pipe are retried soon, nothing wakes
+      // this thread when it drains.
+      lock_type lock(m_mutex);
+      idle = backlog() ? 1 : m_io.response_timeout();
+    }
+
+    // Only complete frames are decoded, recieve_frame() would throw away a
+    // frame still arriving each time the link idles for its timeout.
+    Frame      frame(Frame::Type::UNSET);
+    const bool received = m_io.wait_for_frame(idle) && m_io.try_recieve_frame(frame);
+
+    bool             deliver = false;
+    ConnectionStatus status;
+    {
+      lock_type lock(m_mutex);
+      if (received)
+        deliver = handle(frame);
+      timers();
+      // Acknowledge once there is nothing more to read, unless an
+      // information frame has done so already.
+      if (m_ack_pending && m_io.in_frame_count() == 0)
+        send_status(Frame::Type::RR, false);
+      pump();
+      status = get_status();
+    }
+    m_changed.notify();
+
+    if (deliver && m_information_handler)
+      m_information_handler(frame);
+    return status;
+  }
+
+private:
+  template <typename buffer_t>
+  sent_frame make_entry(const buffer_t& buffer) const
+  {
+    sent_frame entry;
+    entry.frame = Frame(buffer, Frame::Type::I, false, remote());
+    entry.bytes = frame_bytes<typename io_t::serializer_type>(entry);
+    return entry;
+  }
+
+  /**
+   * @brief      Sends a frame if the window has room for it, the entry is
+   *             only taken then. Called with the lock held.
+   */
+  StatusError queue(sent_frame& entry)
+  {
+    if (!Session::connected())
+      return StatusError::ConnectionError;
+    if (!has_room(window(), entry.bytes))
+      return StatusError::Busy;
+    return transmit_new(std::move(entry));
+  }
+
+  /**
+   * @brief      Waits until the predicate holds or the link is down.
+   */
+  template <typename predicate_t>
+  void wait(predicate_t&& ready)
+  {
+    auto done = [&] {
+      lock_type lock(m_mutex);
+      return !Session::connected() || ready();
+    };
+    while (!m_changed.wait_for(retransmit_timeout(), done))
+    {
+    }
+  }
+
+  /**
+   * @return     true if frame is information to pass to the handler.
+   */
+  bool handle(const Frame& frame)
+  {
+    const bool command = frame.get_address() == local();
+    if (!command && frame.get_address() != remote())
+      return false;
+
+    if (frame.is_unnumbered())
+    {
+      handle_unnumbered(frame, command);
+      return false;
+    }
+
+    if (!Session::connected())
+    {
+      if (command && frame.is_poll())
+        send(Frame(Frame::Type::SARM_DM, true, local()));
+      return false;
+    }
+
+    if (!acknowledge(frame.get_recieve_sequence()))
+    {
+      // Acknowledges a frame never sent, nothing can be trusted.
+      send(Frame(Frame::Type::SARM_DM, true, local()));
+      drop();
+      return false;
+    }
+
+    bool deliver = false;
+    if (frame.is_information())
+    {
+      deliver = frame.get_send_sequence() == m_recieve_seq;
+      if (deliver)
+      {
+        m_recieve_seq = next(m_recieve_seq);
+        m_rejecting   = false;
+        m_ack_pending = true;
+      }
+      else if (!m_rejecting)
+      {
+        m_rejecting = true;
+        send_status(Frame::Type::REJ, false);
+      }
+    }
+
+    if (command && frame.is_poll())
+    {
+      send_status(m_rejecting ? Frame::Type::REJ : Frame::Type::RR, true);
+    }
+    else if (!command && frame.is_final() && m_polling)
+    {
+      // Checkpoint, frames sent before the poll which are still not
+      // acknowledged were lost. Those sent after it may still be on their
+      // way and are only repeated along with the lost ones (go back N).
+      m_polling       = false;
+      m_retries       = 0;
+      if (lost_at_poll())
+        retransmit();
+    }
+    else if (frame.get_type() == Frame::Type::REJ)
+    {
+      retransmit();
+    }
+    return deliver;
+  }
+
+  void handle_unnumbered(const Frame& frame, const bool command)
+  {
+    switch (frame.get_type())
+    {
+    case Frame::Type::SABM:
+    case Frame::Type::SABME:
+      if (command)
+      {
+        set_up(frame.get_type() == Frame::Type::SABME ? ControlField::Extended : ControlField::Basic);
+        send(Frame(Frame::Type::UA, frame.is_poll(), local()));
+      }
+      break;
+
+    case Frame::Type::UA:
+      if (!command && get_status() == ConnectionStatus::Connecting)
+        set_up(m_extended ? ControlField::Extended : ControlField::Basic);
+      break;
+
+    case Frame::Type::DISC_RD:
+      if (command)
+      {
+        send(Frame(Frame::Type::UA, frame.is_poll(), local()));
+        drop();
+      }
+      break;
+
+    case Frame::Type::SARM_DM:
+      if (!command)
+        drop();
+      break;
+
+    default: break;
+    }
+  }
+
+  /**
+   * @brief      Releases the frames acknowledged by N(R).
+   *
+   * @return     false if N(R) acknowledges a frame which was never sent.
+   */
+  bool acknowledge(const uint8_t nr)
+  {
+    if (!acknowledges_sent(nr))
+      return false;
+
+    if (release(nr))
+    {
+      m_retries     = 0;
+      m_timer_start = m_io.get_tick();
+    }
+    // Frames sent before a go back may be acknowledged past V(T).
+    if (distance(m_ack_seq, m_transmit_seq) > WindowedSession::outstanding())
+      m_transmit_seq = m_ack_seq;
+    return true;
+  }
+
+  void timers(void)
+  {
+    if (!Session::connected() || m_ack_seq == m_send_seq || !m_io.is_expired(m_timer_start, m_retransmit_timeout))
+      return;
+
+    if (m_polling && ++m_retries > max_retries)
+    {
+      send(Frame(Frame::Type::SARM_DM, true, local()));
+      drop();
+      return;
+    }
+
+    // Ask which frames arrived, the final answer repeats the rest.
+    m_polling  = true;
+    m_poll_seq = m_transmit_seq;
+    send(Frame(Frame::Type::RR, true, remote(), m_recieve_seq));
+    m_ack_pending = false;
+    m_timer_start = m_io.get_tick();
+  }
+
+  StatusError transmit_new(sent_frame&& entry)
+  {
+    if (m_ack_seq == m_send_seq)
+      m_timer_start = m_io.get_tick();
+
+    push(std::move(entry));
+    pump();
+    return StatusError::Success;
+  }
+
+  bool transmit(const uint8_t seq)
+  {
+    auto& frame = m_sent[seq].frame;
+    frame.set_send_sequence(seq);
+    frame.set_recieve_sequence(m_recieve_seq);
+    if (!m_io.send_frame(frame))
+      return false;
+    m_ack_pending = false;
+    return true;
+  }
+
+  /**
+   * @brief      Sends every frame not acknowledged again (go back N).
+   */
+  void retransmit(void)
+  {
+    m_transmit_seq = m_ack_seq;
+    pump();
+    m_timer_start = m_io.get_tick();
+  }
+
+  /**
+   * @brief      true while frames wait for room in the out pipe.
+   */
+  bool backlog(void) const noexcept { return !m_pending.empty() || m_transmit_seq != m_send_seq; }
+
+  /**
+   * @brief      Sends what waits for the out pipe until it is full, queued
+   *             frames first and then the window from V(T).
+   */
+  void pump(void)
+  {
+    for (; !m_pending.empty(); m_pending.pop_front())
+    {
+      if (!m_io.send_frame(m_pending.front()))
+        return;
+    }
+    for (; m_transmit_seq != m_send_seq; m_transmit_seq = next(m_transmit_seq))
+    {
+      if (!transmit(m_transmit_seq))
+        return;
+    }
+  }
+
+  void send_status(const Frame::Type type, const bool final)
+  {
+    send(Frame(type, final, local(), m_recieve_seq));
+    m_ack_pending = false;
+  }
+
+  /**
+   * @brief      Sends a frame other than information, or queues it behind
+   *             frames already waiting for the out pipe.
+   *
+   * @return     false if the queue is full too, the frame is dropped.
+   */
+  bool send(const Frame& frame)
+  {
+    if (m_pending.empty() && m_io.send_frame(frame))
+      return true;
+    if (m_pending.size() >= max_pending)
+      return false;
+    m_pending.push_back(frame);
+    return true;
+  }
+
+  /**
+   * @brief      Connects with the control field the SABM or SABME asked for,
+   *             frames after it are decoded in that format.
+   */
+  void set_up(const ControlField field)
+  {
+    set_control_field(field);
+    m_io.set_control_field(field);
+    // Whatever still waits belongs to the previous link.
+    m_pending.clear();
+    reset_link();
+    set_status(ConnectionStatus::Connected);
+  }
+
+  void reset_link(void)
+  {
+    reset_sent();
+    m_transmit_seq = 0;
+    m_rejecting    = false;
+    m_ack_pending  = false;
+    m_polling      = false;
+    m_retries      = 0;
+  }
+
+  void drop(void)
+  {
+    disconnect();
+    reset_link();
+  }
+
+  io_t&                     m_io;
+  mutable mutex_type        m_mutex;                      //! Guards the session and window state and everything below but the handler.
+  mutex_sync::notifier_type m_changed;                    //! Signalled when frames are acknowledged or the link changes.
+  size_t                    m_retransmit_timeout = 1000;  //! Ticks before unacknowledged frames are polled for.
+  size_t                    m_timer_start        = 0;     //! Tick of the last progress on the frames in flight.
+  size_t                    m_retries            = 0;     //! Polls which went unanswered in a row.
+  bool                      m_extended           = false; //! Set up the link with SABME.
+  bool                      m_polling            = false; //! Poll sent, final not yet received.
+  bool                      m_rejecting          = false; //! REJ sent, waiting for V(R).
+  bool                      m_ack_pending        = false; //! Frames received which were not acknowledged yet.
+  uint8_t                   m_transmit_seq       = 0;     //! V(T), N(S) of the next frame of the window to put in the out pipe.
+  std::deque<Frame>         m_pending;                    //! Frames other than information waiting for the out pipe.
+  information_handler       m_information_handler;
+};
+
+} // namespace abm
+} // namespace session
+} // namespace hdlc
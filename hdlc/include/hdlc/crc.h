@@ -0,0 +1,221 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+
+#include "types.h"
+#include <stddef.h>
+#include <stdint.h>
+
+namespace hdlc
+{
+namespace crc
+{
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Lookup tables for a table driven CRC.
+ *
+ * @tparam     value_t  CRC register type.
+ * @tparam     slices   Number of 256 entry tables, one per byte processed in
+ *                      a single step.
+ */
+template <typename value_t, size_t slices>
+struct table
+{
+  value_t data[slices][256];
+};
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Generates slice-by-N tables for a non-reflected (MSB first)
+ *             16 bit CRC.
+ *
+ * @param[in]  poly    The polynomial without the implicit x^16 term.
+ *
+ * @tparam     slices  Number of tables.
+ *
+ * @return     The tables, data[k][i] is the CRC of byte i followed by k zero
+ *             bytes.
+ */
+template <size_t slices>
+constexpr table<uint16_t, slices> make_table16(const uint16_t poly)
+{
+  table<uint16_t, slices> t{};
+
+  for (size_t i = 0; i < 256; ++i)
+  {
+    uint16_t crc = static_cast<uint16_t>(i << 8);
+    for (auto bit = 0; bit < 8; ++bit)
+    {
+      crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ poly) : static_cast<uint16_t>(crc << 1);
+    }
+    t.data[0][i] = crc;
+  }
+
+  for (size_t k = 1; k < slices; ++k)
+  {
+    for (size_t i = 0; i < 256; ++i)
+    {
+      const auto prev = t.data[k - 1][i];
+      t.data[k][i]    = static_cast<uint16_t>((prev << 8) ^ t.data[0][prev >> 8]);
+    }
+  }
+
+  return t;
+}
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Generates slice-by-N tables for a reflected (LSB first) 32 bit
+ *             CRC.
+ *
+ * @param[in]  poly    The reflected polynomial.
+ *
+ * @tparam     slices  Number of tables.
+ *
+ * @return     The tables, data[k][i] is the CRC of byte i followed by k zero
+ *             bytes.
+ */
+template <size_t slices>
+constexpr table<uint32_t, slices> make_table32_reflected(const uint32_t poly)
+{
+  table<uint32_t, slices> t{};
+
+  for (size_t i = 0; i < 256; ++i)
+  {
+    uint32_t crc = static_cast<uint32_t>(i);
+    for (auto bit = 0; bit < 8; ++bit)
+    {
+      crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+    }
+    t.data[0][i] = crc;
+  }
+
+  for (size_t k = 1; k < slices; ++k)
+  {
+    for (size_t i = 0; i < 256; ++i)
+    {
+      const auto prev = t.data[k - 1][i];
+      t.data[k][i]    = (prev >> 8) ^ t.data[0][prev & 0xFF];
+    }
+  }
+
+  return t;
+}
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Implementation used by the update() functions.
+ */
+enum class kernel
+{
+  table, //! Portable slice-by-8 tables.
+  clmul, //! x86-64 carry-less multiply folding (PCLMULQDQ).
+};
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Returns the kernel selected for this CPU.
+ *
+ * @details    The kernel is chosen once, on first use, by querying CPUID.
+ */
+kernel active_kernel(void) noexcept;
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      CRC-16/CCITT as used for the 16 bit FCS.
+ *
+ * @details    Polynomial 0x1021, initial value 0xFFFF, MSB first with no final
+ *             xor. Matches boost::crc_basic<16>(0x1021, 0xFFFF, 0, false,
+ *             false) which the serializer has always used.
+ */
+struct ccitt16
+{
+  using value_type = uint16_t;
+
+  static constexpr value_type poly      = 0x1021;
+  static constexpr value_type initial   = 0xFFFF;
+  static constexpr value_type final_xor = 0x0000;
+
+  /**
+   * @brief      Updates the CRC over a block of bytes using the fastest kernel
+   *             available on this CPU.
+   *
+   * @param[in]  crc    The current CRC register
+   * @param[in]  begin  Pointer to first byte
+   * @param[in]  end    Pointer past the last byte
+   *
+   * @return     Updated CRC register
+   */
+  static value_type update(value_type crc, const uint8_t* begin, const uint8_t* end) noexcept;
+
+  /**
+   * @brief      Same as above using the portable slice-by-8 tables.
+   */
+  static value_type update_table(value_type crc, const uint8_t* begin, const uint8_t* end) noexcept;
+
+  /**
+   * @brief      Same as above but processes one byte per step, used as the
+   *             reference for tests and benchmarks.
+   */
+  static value_type update_bytewise(value_type crc, const uint8_t* begin, const uint8_t* end) noexcept;
+
+  static constexpr value_type finalize(const value_type crc) noexcept { return crc ^ final_xor; }
+  static value_type           compute(const uint8_t* begin, const uint8_t* end) noexcept { return finalize(update(initial, begin, end)); }
+};
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      CRC-32 as used for the 32 bit FCS.
+ *
+ * @details    Reflected polynomial 0xEDB88320 (0x04C11DB7), initial value and
+ *             final xor 0xFFFFFFFF. This is the ISO 3309 / ITU-T V.42 FCS-32.
+ */
+struct crc32
+{
+  using value_type = uint32_t;
+
+  static constexpr value_type poly      = 0xEDB88320;
+  static constexpr value_type initial   = 0xFFFFFFFF;
+  static constexpr value_type final_xor = 0xFFFFFFFF;
+
+  static value_type update(value_type crc, const uint8_t* begin, const uint8_t* end) noexcept;
+  static value_type update_table(value_type crc, const uint8_t* begin, const uint8_t* end) noexcept;
+  static value_type update_bytewise(value_type crc, const uint8_t* begin, const uint8_t* end) noexcept;
+
+  static constexpr value_type finalize(const value_type crc) noexcept { return crc ^ final_xor; }
+  static value_type           compute(const uint8_t* begin, const uint8_t* end) noexcept { return finalize(update(initial, begin, end)); }
+};
+
+#if HDLC_USE_CLMUL
+namespace detail
+{
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Carry-less multiply kernels.
+ *
+ * @details    Fold the buffer 64 bytes at a time with PCLMULQDQ and finish the
+ *             remainder with the tables. Must only be called when
+ *             clmul_supported() returns true.
+ */
+bool                clmul_supported(void) noexcept;
+ccitt16::value_type ccitt16_clmul(ccitt16::value_type crc, const uint8_t* begin, const uint8_t* end) noexcept;
+crc32::value_type   crc32_clmul(crc32::value_type crc, const uint8_t* begin, const uint8_t* end) noexcept;
+} // namespace detail
+#endif
+
+} // namespace crc
+} // namespace hdlc
@@ -0,0 +1,84 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+
+#include "crc.h"
+#include "types.h"
+#include <stddef.h>
+
+namespace hdlc
+{
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Frame check sequence policy.
+ *
+ * @tparam     crc_t  CRC engine, see crc.h
+ *
+ * @details    Describes the width of the FCS and how it is placed on the
+ *             wire (least significant byte first). Everything is known at
+ *             compile time so each policy compiles to straight-line code.
+ */
+template <typename crc_t>
+struct basic_fcs
+{
+  using crc_type   = crc_t;
+  using value_type = typename crc_t::value_type;
+
+  static constexpr size_t size           = sizeof(value_type); //! FCS size in bytes.
+  static constexpr size_t frame_min_size = 4 + size;           //! Flag, address, control, FCS, flag.
+
+  /**
+   * @brief      Writes the FCS least significant byte first.
+   *
+   * @param[in]  fcs   The FCS
+   * @param[in]  out   Output iterator
+   *
+   * @return     Output iterator past the last written byte.
+   */
+  template <typename out_iter_t>
+  static out_iter_t write(const value_type fcs, out_iter_t out)
+  {
+    for (size_t i = 0; i < size; ++i)
+    {
+      *out++ = static_cast<uint8_t>(fcs >> (8 * i));
+    }
+    return out;
+  }
+
+  /**
+   * @brief      Reads a FCS written by write()
+   *
+   * @param[in]  in    Iterator to the first FCS byte
+   *
+   * @return     The FCS
+   */
+  template <typename in_iter_t>
+  static value_type read(in_iter_t in)
+  {
+    value_type fcs = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+      fcs |= static_cast<value_type>(static_cast<value_type>(static_cast<uint8_t>(*in++)) << (8 * i));
+    }
+    return fcs;
+  }
+};
+
+template <typename crc_t>
+constexpr size_t basic_fcs<crc_t>::size;
+template <typename crc_t>
+constexpr size_t basic_fcs<crc_t>::frame_min_size;
+
+using fcs16 = basic_fcs<crc::ccitt16>; //! 16 bit FCS, the default.
+using fcs32 = basic_fcs<crc::crc32>;   //! 32 bit FCS.
+
+static_assert(fcs16::frame_min_size == FRAME_MIN_SIZE, "FRAME_MIN_SIZE describes the 16 bit FCS");
+
+} // namespace hdlc
@@ -0,0 +1,195 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+
+#include "io.h"
+#include "reactor.h"
+#include "types.h"
+
+#if HDLC_USE_EPOLL
+
+#include <atomic>
+#include <chrono>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <thread>
+#include <unistd.h>
+
+namespace hdlc
+{
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      IO over a file descriptor, driven by a reactor.
+ *
+ * @tparam     fcs_t   Frame check sequence policy used on this link.
+ * @tparam     pipe_t  Pipe type, see basic_io.
+ *
+ * @details    Works with anything that can be polled, serial ports, ptys,
+ *             sockets and pipes. The descriptor is switched to non blocking
+ *             mode but not closed, it must outlive the object. Register the
+ *             link with a reactor, which then moves bytes between the
+ *             descriptor and the pipes. Sending a frame wakes the reactor
+ *             through an eventfd, at most once until the reactor has flushed.
+ *
+ *             handle_in() and handle_out() may also be called directly
+ *             instead of using a reactor. Bytes are read straight into the
+ *             free space of the in pipe and written straight from the out
+ *             pipe, one readv() or writev() covers both halves of the ring.
+ */
+template <typename fcs_t = fcs16, typename pipe_t = FramePipe>
+class basic_fd_io : public basic_io<fcs_t, pipe_t>, public reactor_link
+{
+public:
+  /**
+   * @param[in]  fd            The descriptor
+   * @param[in]  buffer_size   Size of each pipe
+   * @param[in]  non_blocking  false leaves the descriptor blocking, for
+   *                           running handle_in() and handle_out() on
+   *                           dedicated threads instead of a reactor.
+   */
+  basic_fd_io(const int fd, const size_t buffer_size = 512, const bool non_blocking = true)
+      : basic_io<fcs_t, pipe_t>(buffer_size), m_fd(fd), m_event(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)), m_non_blocking(non_blocking)
+  {
+    const auto flags = ::fcntl(m_fd, F_GETFL);
+    if (flags >= 0 && non_blocking)
+      ::fcntl(m_fd, F_SETFL, flags | O_NONBLOCK);
+  }
+
+  ~basic_fd_io()
+  {
+    if (m_event >= 0)
+      ::close(m_event);
+  }
+
+  int native_handle(void) const override { return m_fd; }
+  int event_handle(void) const override { return m_event; }
+
+  size_t get_tick(void) const override
+  {
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    return static_cast<size_t>(now);
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Reads everything available into the in pipe.
+   *
+   * @return     false once the descriptor has closed or failed.
+   *
+   * @details    Stops early when the in pipe is full. A blocking descriptor
+   *             is read once. Complete frames are passed to the on_frame()
+   *             subscriber.
+   */
+  bool handle_in(void) override
+  {
+    bool open = true;
+
+    for (;;)
+    {
+      const auto space = this->m_in_pipe.writable_regions();
+      if (space.size() == 0)
+        break;
+
+      iovec      parts[2] = {{space.first.data(), space.first.size()}, {space.second.data(), space.second.size()}};
+      const auto count    = ::readv(m_fd, parts, space.second.empty() ? 1 : 2);
+      if (count > 0)
+      {
+        this->m_in_pipe.commit(static_cast<size_t>(count));
+        // A short read means the descriptor is drained, skip the read which
+        // would only return EAGAIN.
+        if (m_non_blocking && static_cast<size_t>(count) == space.size())
+          continue;
+        break;
+      }
+
+      if (count < 0 && errno == EINTR)
+        continue;
+
+      open = (count < 0) && (errno == EAGAIN || errno == EWOULDBLOCK);
+      break;
+    }
+
+    this->dispatch_frames();
+    return open;
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Writes the out pipe until the descriptor would block.
+   *
+   * @return     true once everything queued has been written.
+   */
+  bool handle_out(void) override
+  {
+    m_out_signalled.store(false, std::memory_order_relaxed);
+    // Pairs with the fence in out_queued(), a frame queued after this point
+    // either is seen below or signals again.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    for (;;)
+    {
+      const auto data = this->m_out_pipe.readable_regions();
+      if (data.size() == 0)
+        return true;
+
+      iovec      parts[2] = {{data.first.data(), data.first.size()}, {data.second.data(), data.second.size()}};
+      const auto count    = ::writev(m_fd, parts, data.second.empty() ? 1 : 2);
+      if (count >= 0)
+      {
+        this->m_out_pipe.consume(static_cast<size_t>(count));
+      }
+      else if (errno != EINTR)
+      {
+        return false;
+      }
+    }
+  }
+
+  void reset(void) override
+  {
+    this->m_out_pipe.clear();
+    this->m_in_pipe.clear();
+  }
+
+  void sleep(const size_t ms) override { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+  bool on_readable(void) override { return handle_in(); }
+  bool on_writable(void) override { return handle_out(); }
+  bool in_full(void) override { return this->m_in_pipe.writable_regions().size() == 0; }
+
+protected:
+  void out_queued(void) override
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_out_signalled.exchange(true, std::memory_order_relaxed) || m_event < 0)
+      return;
+
+    const uint64_t one = 1;
+    while (::write(m_event, &one, sizeof(one)) < 0 && errno == EINTR)
+    {
+    }
+  }
+
+private:
+  int               m_fd;                   //! Link descriptor, not owned.
+  int               m_event;                //! Readable while output is queued.
+  bool              m_non_blocking;         //! The descriptor was switched to non blocking mode.
+  std::atomic<bool> m_out_signalled{false}; //! m_event written since the last flush.
+};
+
+using fd_io = basic_fd_io<>; //! Descriptor backed IO using the default 16 bit FCS.
+
+} // namespace hdlc
+
+#endif
@@ -7,15 +7,27 @@
 
 #pragma once
 
+#include "pool.h"
+#include "small_buffer.h"
 #include "types.h"
+#include <utility>
 #include <vector>
 
 namespace hdlc
 {
 
+class FrameView;
+
 class Frame
 {
 public:
+#if HDLC_USE_FRAME_POOL
+  using allocator_type = pool::allocator<uint8_t>;
+#else
+  using allocator_type = std::allocator<uint8_t>;
+#endif
+  using payload_type = small_buffer<HDLC_FRAME_INLINE_PAYLOAD, allocator_type>; //! Small payloads are stored inline.
+
   enum class Type : uint8_t
   {
     I = 0b00000000,
@@ -63,7 +75,7 @@ public:
    */
   Frame(const Type type = Type::UNSET, const bool poll = true, const uint8_t address = 0xFF, const uint8_t recieve_seq = 0,
         const uint8_t send_seq = 0)
-      : m_type(type), m_poll_flag(poll), m_address(address), m_recieve_seq(recieve_seq & 0b111), m_send_seq(send_seq & 0b111)
+      : m_type(type), m_poll_flag(poll), m_address(address), m_recieve_seq(recieve_seq & 0x7F), m_send_seq(send_seq & 0x7F)
   {
   }
 
@@ -86,7 +98,7 @@ public:
   template <typename buffer_t>
   Frame(const buffer_t& buffer, const Type type = Type::I, const bool poll = true, const uint8_t address = 0xFF,
         const uint8_t recieve_seq = 0, const uint8_t send_seq = 0)
-      : m_type(type), m_poll_flag(poll), m_address(address), m_recieve_seq(recieve_seq & 0b111), m_send_seq(send_seq & 0b111),
+      : m_type(type), m_poll_flag(poll), m_address(address), m_recieve_seq(recieve_seq & 0x7F), m_send_seq(send_seq & 0x7F),
         m_payload(buffer.begin(), buffer.end())
   {
   }
@@ -110,19 +122,28 @@ public:
   template <typename iter_t>
   Frame(iter_t begin, iter_t end, const Type type = Type::I, const bool poll = true, const uint8_t address = 0xFF,
         const uint8_t recieve_seq = 0, const uint8_t send_seq = 0)
-      : m_type(type), m_poll_flag(poll), m_address(address), m_recieve_seq(recieve_seq & 0b111), m_send_seq(send_seq & 0b111),
+      : m_type(type), m_poll_flag(poll), m_address(address), m_recieve_seq(recieve_seq & 0x7F), m_send_seq(send_seq & 0x7F),
         m_payload(begin, end)
   {
   }
 
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Copies a frame view into an owning frame.
+   *
+   * @param[in]  view  The view, see frame_view.h
+   */
+  explicit Frame(const FrameView& view);
+
   void set_address(const uint8_t address) noexcept { m_address = address; }
   auto get_address(void) const noexcept { return m_address; }
   void set_type(const Type type) noexcept { m_type = type; }
   auto get_type() const noexcept { return m_type; }
   void set_poll(bool poll) noexcept { m_poll_flag = poll; }
-  void set_recieve_sequence(const uint8_t sequence) noexcept { m_recieve_seq = sequence & 0b111; }
+  void set_recieve_sequence(const uint8_t sequence) noexcept { m_recieve_seq = sequence & 0x7F; }
   auto get_recieve_sequence() const noexcept { return (is_unnumbered()) ? 0 : m_recieve_seq; }
-  void set_send_sequence(const uint8_t sequence) noexcept { m_send_seq = sequence & 0b111; }
+  void set_send_sequence(const uint8_t sequence) noexcept { m_send_seq = sequence & 0x7F; }
   auto get_send_sequence() const noexcept { return is_information() ? m_send_seq : 0; }
 
   auto is_payload_type() const noexcept { return m_type == Type::I || m_type == Type::UI || m_type == Type::TEST; }
@@ -135,17 +156,22 @@ public:
   auto is_poll() const noexcept { return m_poll_flag; }
   auto is_final() const noexcept { return is_poll(); }
 
-  auto                        begin() const { return m_payload.begin(); }
-  auto                        end() const { return m_payload.end(); }
-  auto                        payload_size() const noexcept { return m_payload.size(); }
-  const std::vector<uint8_t>& get_payload() const { return m_payload; }
-  auto                        has_payload() const noexcept { return !m_payload.empty(); }
-  void                        set_payload(const std::vector<unsigned char>& payload) { m_payload = payload; }
+  auto                begin() const { return m_payload.begin(); }
+  auto                end() const { return m_payload.end(); }
+  auto                payload_size() const noexcept { return m_payload.size(); }
+  const payload_type& get_payload() const { return m_payload; }
+  auto                has_payload() const noexcept { return !m_payload.empty(); }
+  void                set_payload(const payload_type& payload) { m_payload = payload; }
+  void                set_payload(payload_type&& payload) { m_payload = std::move(payload); }
+  template <typename buffer_t>
+  void set_payload(const buffer_t& payload)
+  {
+    m_payload.assign(payload.begin(), payload.end());
+  }
   template <typename iter_t>
   void set_payload(iter_t begin, iter_t end)
   {
-    m_payload.reserve(end - begin);
-    copy(begin, end, std::back_inserter(m_payload));
+    m_payload.assign(begin, end);
   }
 
   /**
@@ -192,9 +218,9 @@ private:
   Type                 m_type        = Type::UNSET; //! Stores the frame type.
   bool                 m_poll_flag   = false;       //! Poll flag
   uint8_t              m_address     = 0xFF;        //! Address
-  uint8_t              m_recieve_seq = 0;           //! Receive sequence, only lower 3 bits matter
-  uint8_t              m_send_seq    = 0;           //! Send sequence, only lower 3 bits matter.
-  std::vector<uint8_t> m_payload;                   //! Payload. Not sure if vector is the correct choice here.
+  uint8_t              m_recieve_seq = 0;           //! Receive sequence, only lower 7 bits matter
+  uint8_t              m_send_seq    = 0;           //! Send sequence, only lower 7 bits matter.
+  payload_type         m_payload;                   //! Payload, inline up to HDLC_FRAME_INLINE_PAYLOAD bytes.
 };
 
 } // namespace hdlc
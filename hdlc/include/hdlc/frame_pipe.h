@@ -6,26 +6,204 @@
  */
 
 #pragma once
+#include "ring_storage.h"
+#include "span.h"
+#include "stuffing.h"
 #include "types.h"
-#include <boost/circular_buffer.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <vector>
 
+#if HDLC_USE_STD_MUTEX
+#include <chrono>
+#include <condition_variable>
+#endif
+
 namespace hdlc
 {
 
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Mutex which does nothing, for pipes which need no locking.
+ */
+struct null_mutex
+{
+  void lock(void) noexcept {}
+  void unlock(void) noexcept {}
+};
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Index with the std::atomic interface which is not atomic, for
+ *             pipes which are locked.
+ */
+template <typename T>
+class plain_index
+{
+public:
+  constexpr plain_index(const T value = T()) noexcept : m_value(value) {}
+
+  T    load(const std::memory_order = std::memory_order_seq_cst) const noexcept { return m_value; }
+  void store(const T value, const std::memory_order = std::memory_order_seq_cst) noexcept { m_value = value; }
+
+private:
+  T m_value;
+};
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Frame notification for platforms without threads, waiting
+ *             returns straight away.
+ */
+struct null_notifier
+{
+  template <typename predicate_t>
+  bool wait_for(const size_t, predicate_t&& ready)
+  {
+    return ready();
+  }
+  void notify(void) noexcept {}
+};
+
+#if HDLC_USE_STD_MUTEX
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Frame notification through a condition variable.
+ *
+ * @details    The producer only takes the lock when a consumer is waiting,
+ *             so notifying an idle link costs a fence and a load.
+ *             notify() must not be called with the pipe mutex held since
+ *             the waiting consumer evaluates its predicate under the
+ *             notifier mutex.
+ */
+class cv_notifier
+{
+public:
+  template <typename predicate_t>
+  bool wait_for(const size_t timeout_ms, predicate_t&& ready)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_waiters.fetch_add(1, std::memory_order_seq_cst);
+    const auto arrived = m_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), ready);
+    m_waiters.fetch_sub(1, std::memory_order_relaxed);
+    return arrived;
+  }
+
+  void notify(void)
+  {
+    // Orders the published tail before the check for waiters, pairs with
+    // the increment in wait_for().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_waiters.load(std::memory_order_relaxed) == 0)
+      return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cv.notify_all();
+  }
+
+private:
+  std::mutex              m_mutex;
+  std::condition_variable m_cv;
+  std::atomic<unsigned>   m_waiters{0};
+};
+#endif
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Pipe synchronisation where every operation takes a mutex. Any
+ *             number of threads may use the pipe.
+ */
+struct mutex_sync
+{
+#if HDLC_USE_STD_MUTEX
+  using mutex_type    = std::mutex;
+  using notifier_type = cv_notifier;
+#else
+  using mutex_type    = null_mutex;
+  using notifier_type = null_notifier;
+#endif
+  template <typename T>
+  using index_type = plain_index<T>;
+};
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Wait-free single producer, single consumer synchronisation.
+ *
+ * @details    No locks are taken. One thread may write (write(), write_frame(),
+ *             writable_regions(), commit(), full(), space()) while one other
+ *             thread reads (read(), read_frame(), readable_regions(),
+ *             consume(), clear(), clear_partial(), frame_count(),
+ *             wait_for_frame() ...). The head and tail are published with
+ *             release/acquire ordering.
+ */
+struct spsc_sync
+{
+  using mutex_type = null_mutex;
+#if HDLC_USE_STD_MUTEX
+  using notifier_type = cv_notifier;
+#else
+  using notifier_type = null_notifier;
+#endif
+  template <typename T>
+  using index_type = std::atomic<T>;
+};
+
 /**
  * @author     lokraszewski
  * @date       21-Nov-2018
  * @brief      Class for frame pipe.
  *
- * @details    Can be used for both sending and recieiving frame buffers. Wraps around boost circular buffer
+ * @tparam     sync_t     Synchronisation policy, mutex_sync or spsc_sync.
+ * @tparam     storage_t  Ring storage, heap_ring or mirrored_ring.
+ *
+ * @details    Can be used for both sending and recieiving frame buffers. Wraps
+ *             a fixed size ring buffer which is allocated once on
+ *             construction. The position of every frame boundary is queued
+ *             as it is written, so extracting a frame costs the length of
+ *             the frame rather than the amount of buffered data.
+ *
+ *             The head and tail are free running byte positions, the
+ *             consumer owns the head and the producer owns the tail and each
+ *             sits on its own cache line. Boundaries are published before
+ *             the bytes they belong to, so the consumer only trusts
+ *             boundaries below the tail it has seen.
  */
-class FramePipe
+template <typename sync_t, typename storage_t = heap_ring>
+class BasicFramePipe
 {
+  using mutex_type    = typename sync_t::mutex_type;
+  using notifier_type = typename sync_t::notifier_type;
+  using guard         = std::lock_guard<mutex_type>;
+  template <typename T>
+  using index_type = typename sync_t::template index_type<T>;
+
+  static constexpr size_t cache_line_size = 64;
+
 public:
-  FramePipe(const size_t buffer_size) : m_buffer(buffer_size) {}
-  ~FramePipe() {}
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Constructs the pipe.
+   *
+   * @param[in]  buffer_size     The buffer size in bytes, mirrored_ring
+   *                             rounds it up to whole pages.
+   * @param[in]  min_frame_size  The smallest valid frame including both
+   *                             boundaries, depends on the FCS width.
+   */
+  BasicFramePipe(const size_t buffer_size, const size_t min_frame_size = FRAME_MIN_SIZE)
+      : m_min_frame_size(min_frame_size), m_buffer(buffer_size), m_boundaries(m_buffer.size())
+  {
+  }
+  ~BasicFramePipe() {}
 
   /**
    * @author     lokraszewski
@@ -35,13 +213,7 @@ public:
    * @return     true if full
    *
    */
-  auto full() const noexcept
-  {
-#if HDLC_USE_STD_MUTEX
-    std::lock_guard<std::mutex> _l(m_mutex);
-#endif
-    return m_buffer.full();
-  }
+  auto full() const noexcept { return size() == m_buffer.size(); }
   /**
    * @author     lokraszewski
    * @date       28-Feb-2019
@@ -49,13 +221,7 @@ public:
    *
    * @return     True if empty
    */
-  auto empty() const noexcept
-  {
-#if HDLC_USE_STD_MUTEX
-    std::lock_guard<std::mutex> _l(m_mutex);
-#endif
-    return m_buffer.empty();
-  }
+  auto empty() const noexcept { return size() == 0; }
 
   /**
    * @author     lokraszewski
@@ -65,13 +231,7 @@ public:
    * @return     Pipe size is bytes.
    *
    */
-  auto capacity() const noexcept
-  {
-#if HDLC_USE_STD_MUTEX
-    std::lock_guard<std::mutex> _l(m_mutex);
-#endif
-    return m_buffer.capacity();
-  }
+  auto capacity() const noexcept { return m_buffer.size(); }
 
   /**
    * @author     lokraszewski
@@ -81,12 +241,11 @@ public:
    * @return     Size in bytes
    *
    */
-  auto size() const noexcept
+  size_t size() const noexcept
   {
-#if HDLC_USE_STD_MUTEX
-    std::lock_guard<std::mutex> _l(m_mutex);
-#endif
-    return m_buffer.size();
+    guard      _l(m_mutex);
+    const auto tail = m_tail.load(std::memory_order_acquire);
+    return tail - m_head.load(std::memory_order_acquire);
   }
 
   /**
@@ -103,14 +262,16 @@ public:
    * @author     lokraszewski
    * @date       28-Feb-2019
    * @brief      Clears all bytes.
+   *
+   * @details    With spsc_sync this is a consumer operation, bytes written
+   *             concurrently may remain.
    */
   void clear(void)
   {
-#if HDLC_USE_STD_MUTEX
-    std::lock_guard<std::mutex> _l(m_mutex);
-#endif
-    m_buffer.clear();
-    m_boundary_count = 0;
+    guard      _l(m_mutex);
+    const auto tail = m_tail.load(std::memory_order_acquire);
+    pop_boundaries(boundaries_before(tail));
+    retire(tail - m_head.load(std::memory_order_relaxed));
   }
 
   /**
@@ -123,12 +284,10 @@ public:
    * @details    The boundary count is the number of frame boundaries received.
    *             This is specici to the HDLC protocol
    */
-  auto boundary_count(void) const
+  size_t boundary_count(void) const
   {
-#if HDLC_USE_STD_MUTEX
-    std::lock_guard<std::mutex> _l(m_mutex);
-#endif
-    return m_boundary_count;
+    guard _l(m_mutex);
+    return boundaries_before(m_tail.load(std::memory_order_acquire));
   }
 
   /**
@@ -183,20 +342,43 @@ public:
    */
   uint8_t read(void)
   {
-    if (empty())
+    guard _l(m_mutex);
+    if (m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_relaxed))
       return 0;
 
-#if HDLC_USE_STD_MUTEX
-    std::lock_guard<std::mutex> _l(m_mutex);
-#endif
-    const auto byte = m_buffer.front();
+    const auto byte = m_buffer[m_head_index];
     if (byte == protocol_bytes::frame_boundary)
-      --m_boundary_count;
-    m_buffer.pop_front();
+      pop_boundaries(1);
+    retire(1);
 
     return byte;
   }
 
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Reads as many bytes as are available and fit.
+   *
+   * @param      out   Output space
+   *
+   * @return     Number of bytes read.
+   */
+  size_t read(span<uint8_t> out)
+  {
+    guard      _l(m_mutex);
+    const auto head  = m_head.load(std::memory_order_relaxed);
+    const auto tail  = std::min<size_t>(m_tail.load(std::memory_order_acquire), head + out.size());
+    const auto count = tail - head;
+    if (count == 0)
+      return 0;
+
+    const auto boundaries = boundaries_before(tail);
+    copy_out(0, count, out.begin());
+    pop_boundaries(boundaries);
+    retire(count);
+    return count;
+  }
+
   /**
    * @author     lokraszewski
    * @date       28-Feb-2019
@@ -204,24 +386,25 @@ public:
    *
    * @param      buffer  reference to byte buffer
    *
+   * @tparam     alloc_t  Allocator of the buffer, for example pool::allocator.
+   *
    * @return     Number of bytes read.
    *
    * @details
    */
-  size_t read(std::vector<uint8_t>& buffer)
+  template <typename alloc_t>
+  size_t read(std::vector<uint8_t, alloc_t>& buffer)
   {
-    if (empty())
+    guard      _l(m_mutex);
+    const auto tail  = m_tail.load(std::memory_order_acquire);
+    const auto count = tail - m_head.load(std::memory_order_relaxed);
+    if (count == 0)
       return 0;
 
-    buffer.reserve(size());
-
-#if HDLC_USE_STD_MUTEX
-    std::lock_guard<std::mutex> _l(m_mutex);
-#endif
-
-    std::copy(m_buffer.begin(), m_buffer.end(), std::back_inserter(buffer));
-    m_buffer.clear();
-    m_boundary_count = 0;
+    buffer.reserve(buffer.size() + count);
+    copy_out(0, count, std::back_inserter(buffer));
+    pop_boundaries(boundaries_before(tail));
+    retire(count);
     return buffer.size();
   }
 
@@ -230,40 +413,74 @@ public:
    * @date       28-Feb-2019
    * @brief      Reads a frame.
    *
+   * @tparam     alloc_t  Allocator of the returned vector, for example
+   *                      pool::allocator.
+   *
    * @return     Vector of bytes which spans a frame or empty vector
    *
    * @details    Finds the boundaries of a frame and extracts it from the
-   *             buffer.
+   *             buffer. Boundary pairs too close together to hold a frame
+   *             (for example idle flags) are skipped, as are any bytes before
+   *             the first boundary.
    */
-  std::vector<uint8_t> read_frame()
+  template <typename alloc_t = std::allocator<uint8_t>>
+  std::vector<uint8_t, alloc_t> read_frame()
   {
-    std::vector<uint8_t> buffer;
+    std::vector<uint8_t, alloc_t> buffer;
 
     if (frame_count() == 0)
       return buffer;
 
-#if HDLC_USE_STD_MUTEX
-    std::lock_guard<std::mutex> _l(m_mutex);
-#endif
-
-    auto begin = m_buffer.begin();
-    auto end   = m_buffer.end();
-    auto sof   = std::find(begin, end, protocol_bytes::frame_boundary);   // Find start of frame
-    auto eof   = std::find(sof + 1, end, protocol_bytes::frame_boundary); // Find end of frame
+    guard _l(m_mutex);
 
-    // Check if the boundaries are valid.
-    if (sof != end && eof++ != end)
+    size_t sof, eof;
+    if (locate_frame(sof, eof))
     {
-      buffer.reserve(eof - sof);
-      std::copy(sof, eof, std::back_inserter(buffer));
-      m_buffer.erase(sof, eof);
-      // We know we have found 2 boundaries because sof and eof were not end
-      m_boundary_count -= 2;
+      buffer.reserve(eof - sof + 1);
+      copy_out(sof, eof - sof + 1, std::back_inserter(buffer));
+      pop_boundaries(2);
+      retire(eof + 1);
     }
 
     return buffer;
   }
 
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Reads a frame in place.
+   *
+   * @param      decoder    Called as decoder(first, second) with the frame
+   *                        bytes, including both boundaries, split in up to
+   *                        two spans because of wraparound. The spans are
+   *                        only valid during the call.
+   *
+   * @tparam     decoder_t  Callable type
+   *
+   * @return     true if a frame was found and passed to the decoder.
+   *
+   * @details    Same as above without copying the frame out first. The frame
+   *             is removed from the pipe once the decoder returns.
+   */
+  template <typename decoder_t>
+  bool read_frame(decoder_t&& decoder)
+  {
+    if (frame_count() == 0)
+      return false;
+
+    guard _l(m_mutex);
+
+    size_t sof, eof;
+    if (!locate_frame(sof, eof))
+      return false;
+
+    const auto frame = readable(sof, eof - sof + 1);
+    decoder(span<const uint8_t>(frame.first), span<const uint8_t>(frame.second));
+    pop_boundaries(2);
+    retire(eof + 1);
+    return true;
+  }
+
   /**
    * @author     lokraszewski
    * @date       28-Feb-2019
@@ -276,15 +493,20 @@ public:
    */
   void write(const uint8_t byte)
   {
-    if (full() == false)
     {
-#if HDLC_USE_STD_MUTEX
-      std::lock_guard<std::mutex> _l(m_mutex);
-#endif
+      guard      _l(m_mutex);
+      const auto tail = m_tail.load(std::memory_order_relaxed);
+      if (tail - m_head.load(std::memory_order_acquire) == m_buffer.size())
+        return;
+
+      m_buffer[m_tail_index] = byte;
       if (byte == protocol_bytes::frame_boundary)
-        ++m_boundary_count;
-      m_buffer.push_back(byte);
+        push_boundary(tail);
+      publish(1);
     }
+
+    if (byte == protocol_bytes::frame_boundary)
+      m_notifier.notify();
   }
 
   /**
@@ -297,22 +519,34 @@ public:
    *
    * @tparam     iter_t  Iterator type
    *
-   * @details    Counts boundaries and writes the buffer to the pipe assuming
-   *             there is enough space.
+   * @details    Writes the buffer to the pipe assuming there is enough space
+   *             and indexes the boundaries in it.
    */
   template <typename iter_t>
   void write(iter_t begin, iter_t end)
   {
     const size_t requested_size = end - begin;
-    if ((requested_size) > space())
-      return;
+    bool         boundaries     = false;
 
-#if HDLC_USE_STD_MUTEX
-    std::lock_guard<std::mutex> _l(m_mutex);
-#endif
+    {
+      guard      _l(m_mutex);
+      const auto regions = writable();
+      if (requested_size > regions.first.size() + regions.second.size())
+        return;
+
+      const auto tail   = m_tail.load(std::memory_order_relaxed);
+      const auto first  = std::min(requested_size, regions.first.size());
+      const auto pushed = m_boundaries_pushed;
+      std::copy_n(begin, first, regions.first.begin());
+      std::copy_n(begin + first, requested_size - first, regions.second.begin());
+      index_boundaries(regions.first.first(first), tail);
+      index_boundaries(regions.second.first(requested_size - first), tail + first);
+      publish(requested_size);
+      boundaries = (m_boundaries_pushed != pushed);
+    }
 
-    m_boundary_count += std::count_if(begin, end, [](const auto byte) { return (byte == protocol_bytes::frame_boundary); });
-    m_buffer.insert(m_buffer.end(), begin, end);
+    if (boundaries)
+      m_notifier.notify();
   }
 
   /**
@@ -324,27 +558,402 @@ public:
    *
    * @details    Same as above except for vector reference.
    */
-  void write(const std::vector<uint8_t>& buffer)
+  template <typename alloc_t>
+  void write(const std::vector<uint8_t, alloc_t>& buffer)
   {
-    if (buffer.size() > space())
-      return;
+    write(buffer.begin(), buffer.end());
+  }
 
-#if HDLC_USE_STD_MUTEX
-    std::lock_guard<std::mutex> _l(m_mutex);
-#endif
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Writes as many bytes as fit.
+   *
+   * @param[in]  in    The bytes
+   *
+   * @return     Number of bytes written.
+   *
+   * @details    Unlike the writes above a partial write is allowed, the rest
+   *             can be offered again once the pipe has drained.
+   */
+  size_t write(span<const uint8_t> in)
+  {
+    bool   boundaries = false;
+    size_t count      = 0;
+
+    {
+      guard      _l(m_mutex);
+      const auto regions = writable();
+      const auto tail    = m_tail.load(std::memory_order_relaxed);
+      const auto pushed  = m_boundaries_pushed;
+      count              = std::min(in.size(), regions.size());
+      const auto first   = std::min(count, regions.first.size());
+      std::copy_n(in.begin(), first, regions.first.begin());
+      std::copy_n(in.begin() + first, count - first, regions.second.begin());
+      index_boundaries(regions.first.first(first), tail);
+      index_boundaries(regions.second.first(count - first), tail + first);
+      publish(count);
+      boundaries = (m_boundaries_pushed != pushed);
+    }
 
-    m_boundary_count +=
-        std::count_if(buffer.begin(), buffer.end(), [](const auto byte) { return (byte == protocol_bytes::frame_boundary); });
-    m_buffer.insert(m_buffer.end(), buffer.begin(), buffer.end());
+    if (boundaries)
+      m_notifier.notify();
+    return count;
   }
 
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Writes a single frame directly into the free space of the
+   *             pipe.
+   *
+   * @param      encoder    Called as encoder(first, second) with the free
+   *                        space split in up to two spans because of
+   *                        wraparound. Must write exactly one frame (two
+   *                        boundaries) to the start of first, continuing in
+   *                        second, and return the number of bytes written or
+   *                        0 if the frame did not fit.
+   *
+   * @tparam     encoder_t  Callable type
+   *
+   * @return     true if the frame was written.
+   *
+   * @details    Nothing is committed if the encoder fails, so a frame is
+   *             never partially queued.
+   */
+  template <typename encoder_t>
+  bool write_frame(encoder_t&& encoder)
+  {
+    {
+      guard        _l(m_mutex);
+      const auto   regions = writable();
+      const size_t written = encoder(regions.first, regions.second);
+      if (written == 0)
+        return false;
+
+      // The frame is escaped so its only boundaries are the first and last
+      // byte.
+      const auto tail = m_tail.load(std::memory_order_relaxed);
+      push_boundary(tail);
+      push_boundary(tail + written - 1);
+      publish(written);
+    }
+
+    m_notifier.notify();
+    return true;
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Blocks until a frame is queued.
+   *
+   * @param[in]  timeout_ms  Longest time to wait in milliseconds.
+   *
+   * @return     true if a frame is queued, false on timeout.
+   *
+   * @details    Writers wake the waiting thread whenever they queue a frame
+   *             boundary, so the thread sleeps while the link is idle. Only
+   *             the consumer may wait. Without thread support
+   *             (HDLC_USE_STD_MUTEX is 0) this returns straight away.
+   */
+  bool wait_for_frame(const size_t timeout_ms)
+  {
+    return m_notifier.wait_for(timeout_ms, [this] { return frame_count() > 0; });
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      A region of the ring, second is only used when the region
+   *             wraps around the end of the storage and the storage is not
+   *             mirrored.
+   */
+  struct regions
+  {
+    span<uint8_t> first;
+    span<uint8_t> second;
+
+    size_t size() const noexcept { return first.size() + second.size(); }
+  };
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Returns the free space for writing in place.
+   *
+   * @return     The free space, split in two at the end of the storage.
+   *
+   * @details    For transports which fill the pipe straight from a device,
+   *             for example a read posted to the kernel. Write to the start
+   *             of first, continuing in second, then commit(). The region
+   *             stays valid until then provided the caller is the only
+   *             producer.
+   */
+  regions writable_regions(void)
+  {
+    guard _l(m_mutex);
+    return writable();
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Publishes bytes written into writable_regions().
+   *
+   * @param[in]  count  Number of bytes written, at most the size of the
+   *                    region.
+   *
+   * @details    Indexes the frame boundaries in the bytes and wakes a
+   *             consumer waiting for a frame.
+   */
+  void commit(size_t count)
+  {
+    bool boundaries = false;
+
+    {
+      guard      _l(m_mutex);
+      const auto regions = writable();
+      const auto tail    = m_tail.load(std::memory_order_relaxed);
+      const auto pushed  = m_boundaries_pushed;
+      count              = std::min(count, regions.size());
+      const auto first   = std::min(count, regions.first.size());
+      index_boundaries(regions.first.first(first), tail);
+      index_boundaries(regions.second.first(count - first), tail + first);
+      publish(count);
+      boundaries = (m_boundaries_pushed != pushed);
+    }
+
+    if (boundaries)
+      m_notifier.notify();
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Returns the bytes ready to be read in place.
+   *
+   * @return     Every byte in the pipe, split in two at the end of the
+   *             storage.
+   *
+   * @details    For transports which send straight from the pipe. Call
+   *             consume() once the bytes have been used. The region stays
+   *             valid until then provided the caller is the only consumer.
+   */
+  regions readable_regions(void)
+  {
+    guard _l(m_mutex);
+    return readable(0, m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_relaxed));
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Removes bytes from the front of the pipe.
+   *
+   * @param[in]  count  Number of bytes, at most size().
+   */
+  void consume(size_t count)
+  {
+    guard      _l(m_mutex);
+    const auto head = m_head.load(std::memory_order_relaxed);
+    const auto tail = std::min<size_t>(m_tail.load(std::memory_order_acquire), head + count);
+    count           = tail - head;
+    pop_boundaries(boundaries_before(tail));
+    retire(count);
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Returns the whole storage of the ring.
+   *
+   * @details    Only needed to register the memory with a device or the
+   *             kernel ahead of time, see uring_io.h. The storage does not
+   *             move for the lifetime of the pipe. Includes the second copy
+   *             of a mirrored ring, every region lies within it.
+   */
+  span<uint8_t> storage(void) noexcept { return m_buffer.mapping(); }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Checks if wrapped data is contiguous.
+   *
+   * @return     true if the storage is mirrored, every region and frame is
+   *             then a single span and the second span is always empty.
+   */
+  bool contiguous(void) const noexcept { return m_buffer.mirrored(); }
+
 private:
-#if HDLC_USE_STD_MUTEX
-  mutable std::mutex m_mutex;
-#endif
-  size_t                          m_boundary_count = 0; //! Counts number of frames in the pipe.
-  boost::circular_buffer<uint8_t> m_buffer;             //! Internal storage, relies on boost. It may be better to write or
-                                                        // copy the implemenation to drop the reliance on boost.
+  size_t wrap(const size_t index) const noexcept { return (index >= m_buffer.size()) ? index - m_buffer.size() : index; }
+
+  /*----------  Producer side  ----------*/
+
+  regions writable(void) noexcept
+  {
+    const auto used  = m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_acquire);
+    const auto free  = m_buffer.size() - used;
+    const auto first = m_buffer.mirrored() ? free : std::min(free, m_buffer.size() - m_tail_index);
+    return {span<uint8_t>(m_buffer.data() + m_tail_index, first), span<uint8_t>(m_buffer.data(), free - first)};
+  }
+
+  void push_boundary(const size_t position) noexcept
+  {
+    m_boundaries[m_boundary_tail_index] = static_cast<uint32_t>(position);
+    m_boundary_tail_index               = wrap(m_boundary_tail_index + 1);
+    ++m_boundaries_pushed;
+  }
+
+  /**
+   * @brief      Queues the boundaries in freshly written storage.
+   *
+   * @param[in]  written   The written bytes
+   * @param[in]  position  Position of the first written byte
+   */
+  void index_boundaries(const span<uint8_t> written, const size_t position) noexcept
+  {
+    const uint8_t* it  = written.begin();
+    const uint8_t* end = written.end();
+    while ((it = stuffing::find_flag(it, end)) != end)
+    {
+      push_boundary(position + (it - written.begin()));
+      ++it;
+    }
+  }
+
+  /**
+   * @brief      Publishes written bytes and their boundaries to the consumer.
+   */
+  void publish(const size_t count) noexcept
+  {
+    m_boundary_tail.store(m_boundaries_pushed, std::memory_order_release);
+    m_tail_index = wrap(m_tail_index + count);
+    m_tail.store(m_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+  }
+
+  /*----------  Consumer side  ----------*/
+
+  regions readable(const size_t offset, const size_t count) noexcept
+  {
+    const auto index = wrap(m_head_index + offset);
+    const auto first = m_buffer.mirrored() ? count : std::min(count, m_buffer.size() - index);
+    return {span<uint8_t>(m_buffer.data() + index, first), span<uint8_t>(m_buffer.data(), count - first)};
+  }
+
+  /**
+   * @brief      Offset from the head of a queued boundary.
+   *
+   * @param[in]  i     Position in the queue, 0 is the oldest.
+   */
+  size_t boundary(const size_t i) const noexcept
+  {
+    const auto head = static_cast<uint32_t>(m_head.load(std::memory_order_relaxed));
+    return static_cast<uint32_t>(m_boundaries[wrap(m_boundary_head_index + i)] - head);
+  }
+
+  /**
+   * @brief      Number of queued boundaries below a tail position. The
+   *             producer may have queued boundaries for bytes it has not
+   *             committed yet.
+   *
+   * @param[in]  tail  The tail position, must be loaded before calling.
+   */
+  size_t boundaries_before(const size_t tail) const noexcept
+  {
+    const auto size  = tail - m_head.load(std::memory_order_relaxed);
+    auto       count = m_boundary_tail.load(std::memory_order_acquire) - m_boundary_head;
+    while (count && boundary(count - 1) >= size)
+    {
+      --count;
+    }
+    return count;
+  }
+
+  void pop_boundaries(const size_t count) noexcept
+  {
+    m_boundary_head += count;
+    m_boundary_head_index = wrap(m_boundary_head_index + count);
+  }
+
+  void retire(const size_t count) noexcept
+  {
+    m_head_index = wrap(m_head_index + count);
+    m_head.store(m_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+  }
+
+  /**
+   * @brief      Finds the boundaries of the next frame.
+   *
+   * @param[out] sof   Offset of the opening boundary
+   * @param[out] eof   Offset of the closing boundary
+   *
+   * @return     true if a complete frame was found.
+   *
+   * @details    Boundary pairs too close together to hold a frame are
+   *             dropped, the second boundary is treated as the start of the
+   *             next frame. Bytes before the first boundary are dropped too.
+   */
+  bool locate_frame(size_t& sof, size_t& eof) noexcept
+  {
+    const auto tail  = m_tail.load(std::memory_order_acquire);
+    auto       count = boundaries_before(tail);
+
+    while (count >= 2 && (boundary(1) - boundary(0) + 1) < m_min_frame_size)
+    {
+      pop_boundaries(1);
+      --count;
+    }
+
+    if (count >= 2)
+    {
+      sof = boundary(0);
+      eof = boundary(1);
+      return true;
+    }
+
+    // Nothing before the first boundary can be part of a frame.
+    retire(count ? boundary(0) : tail - m_head.load(std::memory_order_relaxed));
+    return false;
+  }
+
+  template <typename out_iter_t>
+  void copy_out(const size_t offset, const size_t count, out_iter_t out) const
+  {
+    const auto index = wrap(m_head_index + offset);
+    const auto first = m_buffer.mirrored() ? count : std::min(count, m_buffer.size() - index);
+    out              = std::copy_n(m_buffer.data() + index, first, out);
+    std::copy_n(m_buffer.data(), count - first, out);
+  }
+
+  mutable mutex_type    m_mutex;
+  notifier_type         m_notifier;       //! Wakes a consumer waiting for a frame.
+  const size_t          m_min_frame_size; //! Smallest frame including both boundaries.
+  storage_t             m_buffer;         //! Internal storage, allocated once.
+  std::vector<uint32_t> m_boundaries;     //! Positions of the queued boundaries, every byte may be one so it is as long as the storage.
+
+  // Owned by the consumer.
+  alignas(cache_line_size) index_type<size_t> m_head{0}; //! Position of the oldest byte.
+  size_t m_head_index          = 0;                       //! Storage index of the oldest byte.
+  size_t m_boundary_head       = 0;                       //! Number of boundaries popped.
+  size_t m_boundary_head_index = 0;                       //! Index of the oldest queued boundary.
+
+  // Owned by the producer.
+  alignas(cache_line_size) index_type<size_t> m_tail{0}; //! Position past the newest byte.
+  index_type<size_t> m_boundary_tail{0};                  //! Number of boundaries published.
+  size_t             m_tail_index          = 0;           //! Storage index past the newest byte.
+  size_t             m_boundaries_pushed   = 0;           //! Number of boundaries queued.
+  size_t             m_boundary_tail_index = 0;           //! Index past the newest queued boundary.
 };
 
+template <typename sync_t, typename storage_t>
+constexpr size_t BasicFramePipe<sync_t, storage_t>::cache_line_size;
+
+using FramePipe     = BasicFramePipe<mutex_sync>; //! Pipe which any number of threads may share.
+using SpscFramePipe = BasicFramePipe<spsc_sync>;  //! Lock free pipe for one producer and one consumer thread.
+#if HDLC_USE_MIRRORED_RING
+using MirroredFramePipe     = BasicFramePipe<mutex_sync, mirrored_ring>; //! FramePipe where every frame is contiguous.
+using SpscMirroredFramePipe = BasicFramePipe<spsc_sync, mirrored_ring>;  //! SpscFramePipe where every frame is contiguous.
+#endif
+
 } // namespace hdlc
@@ -0,0 +1,125 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+
+#include "frame.h"
+#include "span.h"
+#include "types.h"
+
+#include <algorithm>
+
+namespace hdlc
+{
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Non-owning frame.
+ *
+ * @details    Has the same accessors as Frame but the payload is a span into
+ *             someone else's buffer, usually the buffer the frame was decoded
+ *             into, see BasicFrameSerializer::parse() and decode_view(). The
+ *             view is only valid for as long as that buffer. Construct a
+ *             Frame from the view to keep it.
+ */
+class FrameView
+{
+public:
+  using Type = Frame::Type;
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Construct a view
+   *
+   * @param[in]  type         Type of frame
+   * @param[in]  poll         Whether frame polling
+   * @param[in]  address      The address of the frame
+   * @param[in]  recieve_seq  The recieve sequence
+   * @param[in]  send_seq     The send sequence
+   * @param[in]  payload      The payload, not copied.
+   */
+  constexpr FrameView(const Type type = Type::UNSET, const bool poll = false, const uint8_t address = 0xFF,
+                      const uint8_t recieve_seq = 0, const uint8_t send_seq = 0,
+                      span<const uint8_t> payload = span<const uint8_t>()) noexcept
+      : m_type(type), m_poll_flag(poll), m_address(address), m_recieve_seq(recieve_seq & 0x7F), m_send_seq(send_seq & 0x7F),
+        m_payload(payload)
+  {
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Views an owning frame.
+   */
+  FrameView(const Frame& frame) noexcept
+      : FrameView(frame.get_type(), frame.is_poll(), frame.get_address(), frame.get_recieve_sequence(), frame.get_send_sequence(),
+                  span<const uint8_t>(frame.get_payload().data(), frame.payload_size()))
+  {
+  }
+
+  auto get_address(void) const noexcept { return m_address; }
+  auto get_type() const noexcept { return m_type; }
+  auto get_recieve_sequence() const noexcept { return (is_unnumbered()) ? 0 : m_recieve_seq; }
+  auto get_send_sequence() const noexcept { return is_information() ? m_send_seq : 0; }
+
+  auto is_payload_type() const noexcept { return m_type == Type::I || m_type == Type::UI || m_type == Type::TEST; }
+  auto is_empty() const noexcept { return m_type == Type::UNSET; }
+  auto is_valid() const noexcept { return !is_empty(); }
+  bool is_information() const noexcept { return m_type == Type::I; }
+  bool is_supervisory() const noexcept { return (static_cast<uint8_t>(m_type) & 0b11) == 0b01; }
+  bool is_unnumbered() const noexcept { return !is_empty() && (static_cast<uint8_t>(m_type) & 0b11) == 0b11; }
+
+  auto is_poll() const noexcept { return m_poll_flag; }
+  auto is_final() const noexcept { return is_poll(); }
+
+  auto begin() const noexcept { return m_payload.begin(); }
+  auto end() const noexcept { return m_payload.end(); }
+  auto payload_size() const noexcept { return m_payload.size(); }
+  auto get_payload() const noexcept { return m_payload; }
+  auto has_payload() const noexcept { return !m_payload.empty(); }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Comparison operator, same rules as Frame.
+   */
+  bool operator==(const FrameView& other) const
+  {
+    if (get_type() != other.get_type())
+      return false;
+    if (m_poll_flag != other.is_poll())
+      return false;
+    if (get_recieve_sequence() != other.get_recieve_sequence())
+      return false;
+    if (get_send_sequence() != other.get_send_sequence())
+      return false;
+    if (payload_size() != other.payload_size())
+      return false;
+
+    return std::equal(begin(), end(), other.begin());
+  }
+
+  bool operator!=(const FrameView& other) const { return !(*this == other); }
+
+private:
+  Type                m_type        = Type::UNSET; //! Stores the frame type.
+  bool                m_poll_flag   = false;       //! Poll flag
+  uint8_t             m_address     = 0xFF;        //! Address
+  uint8_t             m_recieve_seq = 0;           //! Receive sequence, only lower 7 bits matter
+  uint8_t             m_send_seq    = 0;           //! Send sequence, only lower 7 bits matter.
+  span<const uint8_t> m_payload;                   //! Payload, points into the decode buffer.
+};
+
+inline Frame::Frame(const FrameView& view)
+    : m_type(view.get_type()), m_poll_flag(view.is_poll()), m_address(view.get_address()),
+      m_recieve_seq(view.get_recieve_sequence()), m_send_seq(view.get_send_sequence()), m_payload(view.begin(), view.end())
+{
+}
+
+} // namespace hdlc
@@ -2,6 +2,8 @@
 #pragma once
 
 #include "frame.h"
+#include "frame_view.h"
+#include "pool.h"
 #include "serializer.h"
 #include "types.h"
 
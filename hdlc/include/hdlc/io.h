@@ -7,10 +7,18 @@
 
 #pragma once
 
+#include "fcs.h"
 #include "frame_pipe.h"
+#include "serializer.h"
 #include "stream_helper.h"
 #include "types.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <vector>
+
 namespace hdlc
 {
 /**
@@ -18,14 +26,29 @@ namespace hdlc
  * @date       21-Nov-2018
  * @brief      Base class for hardware io.
  *
+ * @tparam     fcs_t   Frame check sequence policy used on this link.
+ * @tparam     pipe_t  Pipe type, FramePipe may be shared by any number of
+ *                     threads. SpscFramePipe takes no locks but each pipe
+ *                     must then have one writing and one reading thread, for
+ *                     example an io thread and a protocol thread.
+ *
  * @details    Requires user byte transfer implementaion. Note the pipes are
  *             thread safe.
  */
-class base_io
+template <typename fcs_t = fcs16, typename pipe_t = FramePipe>
+class basic_io
 {
 public:
-  base_io(const size_t buffer_size = 512) : m_out_pipe(buffer_size), m_in_pipe(buffer_size) {}
-  virtual ~base_io() {}
+  using serializer_type = BasicFrameSerializer<fcs_t>;
+  using pipe_type       = pipe_t;
+  using frame_handler   = std::function<void(const FrameView&)>;      //! Called with each frame received.
+  using executor        = std::function<void(std::function<void()>)>; //! Runs a dispatch task, for example on a worker thread.
+
+  basic_io(const size_t buffer_size = 512)
+      : m_out_pipe(buffer_size, serializer_type::frame_min_size), m_in_pipe(buffer_size, serializer_type::frame_min_size)
+  {
+  }
+  virtual ~basic_io() {}
 
   /**
    * @author     lokraszewski
@@ -36,20 +59,42 @@ public:
    *
    * @return     true if successfully written to the out pipe
    *
-   * @details    Takes a frame object and serialisez it into raw bytes to write
-   *             to the out pipe. Note this does not physically send the frame,
-   *             rather it queues it to be sent at the next opportunity.
+   * @details    Takes a frame object and encodes it straight into the free
+   *             space of the out pipe. Note this does not physically send the
+   *             frame, rather it queues it to be sent at the next opportunity.
+   *             Nothing is queued if the frame does not fit.
    */
   bool send_frame(const Frame& f)
   {
-    const auto raw_bytes_tx = FrameSerializer::escape(FrameSerializer::serialize(f));
-
-    // Check if there is enough space in the pipe to send the bytes.
-    if (m_out_pipe.space() < raw_bytes_tx.size())
-      return false;
+    const auto queued = m_out_pipe.write_frame(
+        [&f, field = control_field()](span<uint8_t> first, span<uint8_t> second) { return serializer_type::encode(f, first, second, field); });
+    if (queued)
+      out_queued();
+    return queued;
+  }
 
-    m_out_pipe.write(raw_bytes_tx);
-    return true;
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Sends a frame with the payload gathered from borrowed spans.
+   *
+   * @param[in]  header   Type, address, poll and sequence numbers, the
+   *                      payload of the header is ignored.
+   * @param[in]  payload  Payload parts, sent back to back.
+   *
+   * @return     true if successfully written to the out pipe
+   *
+   * @details    The parts are checksummed and escaped straight into the out
+   *             pipe, the only copy of the payload is the one into the pipe.
+   */
+  bool send_frame(const FrameView& header, span<const span<const uint8_t>> payload)
+  {
+    const auto queued = m_out_pipe.write_frame([&header, payload, field = control_field()](span<uint8_t> first, span<uint8_t> second) {
+      return serializer_type::encode(header, payload, first, second, field);
+    });
+    if (queued)
+      out_queued();
+    return queued;
   }
 
   /**
@@ -62,32 +107,165 @@ public:
    * @return     true if frame is recieved and valid.
    *
    * @details    Checks if there are potential frames in the in pipe, if so the
-   *             frame is decoded and written into the reference object. If no
+   *             frame is decoded in place and written into the reference
+   *             object. Otherwise the thread sleeps until the pipe signals a
+   *             frame. If no
    *             valid frame has arrived within the timeout period the in pipe
    *             is cleared and false is returned.
    */
   bool recieve_frame(Frame& f)
+  {
+    return recieve([this, &f](span<const uint8_t> first, span<const uint8_t> second) {
+      f = serializer_type::decode(first, second, control_field());
+      return f.is_valid();
+    });
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Recieve frame without taking ownership
+   *
+   * @param      view     Reference to a view to write to
+   * @param[in]  storage  Buffer the frame is decoded into, the view points
+   *                      into it. Frames larger than the buffer are dropped,
+   *                      max_recieve_size() bytes always suffice.
+   *
+   * @return     true if frame is recieved and valid.
+   *
+   * @details    Same as above but nothing is allocated, useful when frames
+   *             are only inspected or forwarded.
+   */
+  bool recieve_frame(FrameView& view, span<uint8_t> storage)
+  {
+    return recieve([this, &view, storage](span<const uint8_t> first, span<const uint8_t> second) {
+      view = serializer_type::decode_view(first, second, storage, control_field());
+      return view.is_valid();
+    });
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Decodes the next complete frame in the in pipe, if any.
+   *
+   * @param      f     Reference to a frame to object to write to
+   *
+   * @return     true if a frame was taken and is valid.
+   *
+   * @details    Never waits and never touches a frame still arriving, for
+   *             callers which wait with wait_for_frame() and must not lose
+   *             bytes when that wait runs out.
+   */
+  bool try_recieve_frame(Frame& f)
+  {
+    if (m_in_pipe.frame_count() == 0)
+      return false;
+
+    bool valid = false;
+    m_in_pipe.read_frame([&](span<const uint8_t> first, span<const uint8_t> second) {
+      f     = serializer_type::decode(first, second, control_field());
+      valid = f.is_valid();
+    });
+    return valid;
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Waits until the in pipe holds a complete frame.
+   *
+   * @param[in]  timeout  Ticks to wait at most.
+   *
+   * @return     true if a frame is ready for try_recieve_frame().
+   *
+   * @details    Unlike recieve_frame() a partial frame is left in the pipe
+   *             when the wait runs out.
+   */
+  bool wait_for_frame(const size_t timeout)
   {
     const auto start_tick = get_tick();
+    while (m_in_pipe.frame_count() == 0)
+    {
+      const auto elapsed = get_elapsed(start_tick);
+      if (elapsed >= timeout)
+        return false;
+      m_in_pipe.wait_for_frame(timeout - elapsed);
+    }
+    return true;
+  }
 
-    for (;;)
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Subscribes to received frames.
+   *
+   * @param[in]  handler  Called with each valid frame, an empty handler
+   *                      unsubscribes.
+   * @param[in]  exec     Optional executor, see below.
+   *
+   * @details    Once subscribed every frame reaching the in pipe is decoded
+   *             by dispatch_frames() as soon as its closing flag arrives and
+   *             is passed to the handler instead of recieve_frame(). Without
+   *             an executor the handler runs on the io thread and the view
+   *             points into a decode buffer owned by this object, it is only
+   *             valid during the call. With an executor the frame is copied
+   *             and exec is given a task which calls a copy of the handler,
+   *             so the view stays valid for as long as the task.
+   *
+   *             Subscribing while the io thread is running is safe, changing
+   *             or removing a subscription must not overlap with
+   *             dispatch_frames().
+   */
+  void on_frame(frame_handler handler, executor exec = executor())
+  {
+    m_subscribed.store(false, std::memory_order_relaxed);
+    m_frame_handler = std::move(handler);
+    m_executor      = std::move(exec);
+    m_dispatch_storage.resize(m_frame_handler ? m_in_pipe.capacity() : 0);
+    m_subscribed.store(static_cast<bool>(m_frame_handler), std::memory_order_release);
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Passes every complete frame in the in pipe to the handler.
+   *
+   * @return     Number of valid frames dispatched.
+   *
+   * @details    Called by in_byte(). IO implementations which write to
+   *             m_in_pipe directly call it after each write. Does nothing
+   *             when no handler is subscribed. Frames are decoded in place
+   *             into a buffer allocated by on_frame(), the handler is called
+   *             after the pipe has been released.
+   */
+  size_t dispatch_frames(void)
+  {
+    if (m_subscribed.load(std::memory_order_acquire) == false)
+      return 0;
+
+    size_t dispatched = 0;
+    while (m_in_pipe.frame_count())
     {
-      if (m_in_pipe.frame_count())
+      FrameView view;
+      m_in_pipe.read_frame([&](span<const uint8_t> first, span<const uint8_t> second) {
+        view = serializer_type::decode_view(first, second, span<uint8_t>(m_dispatch_storage.data(), m_dispatch_storage.size()), control_field());
+      });
+
+      if (view.is_valid() == false)
+        continue;
+
+      ++dispatched;
+      if (m_executor)
       {
-        f = FrameSerializer::deserialize(FrameSerializer::descape(m_in_pipe.read_frame()));
-        if (f.is_valid())
-        {
-          return true;
-        }
+        m_executor([handler = m_frame_handler, frame = Frame(view)]() { handler(frame); });
       }
-      else if (is_expired(start_tick, m_response_timeout))
+      else
       {
-        // Clear any partial frames since we dont know if the timeout has
-        // occured mid frame.
-        m_in_pipe.clear_partial();
-        return false;
+        m_frame_handler(view);
       }
     }
+    return dispatched;
   }
 
   size_t in_frame_count(void) const { return m_in_pipe.frame_count(); }
@@ -97,16 +275,56 @@ public:
   auto max_send_size() const { return m_out_pipe.capacity(); }
   auto max_recieve_size() const { return m_in_pipe.capacity(); }
 
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Takes bytes to transmit out of the out pipe.
+   *
+   * @param      out   Output space
+   *
+   * @return     Number of bytes taken, at most the size of out.
+   *
+   * @details    One pipe operation however many bytes are taken. Transports
+   *             which can send straight from the pipe use readable_regions()
+   *             and consume() on m_out_pipe instead.
+   */
+  size_t out_bytes(span<uint8_t> out) { return m_out_pipe.read(out); }
+
   template <typename iter_t>
   auto out_bytes(iter_t begin, iter_t end)
   {
-    while (m_out_pipe.empty() == false && begin < end)
+    std::array<uint8_t, 64> chunk;
+    while (begin < end)
     {
-      *begin++ = m_out_pipe.read();
+      const auto count = out_bytes(span<uint8_t>(chunk.data(), std::min<size_t>(chunk.size(), end - begin)));
+      if (count == 0)
+        break;
+      begin = std::copy_n(chunk.begin(), count, begin);
     }
     return begin;
   }
 
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Passes received bytes to the in pipe.
+   *
+   * @param[in]  in    The bytes
+   *
+   * @return     Number of bytes accepted, fewer than offered if the in pipe
+   *             filled up.
+   *
+   * @details    One pipe operation however many bytes are passed. Complete
+   *             frames are passed to the on_frame() subscriber.
+   */
+  size_t in_bytes(span<const uint8_t> in)
+  {
+    const auto count = m_in_pipe.write(in);
+    if (count)
+      dispatch_frames();
+    return count;
+  }
+
   bool out_byte(uint8_t& byte)
   {
     if (m_out_pipe.empty())
@@ -122,9 +340,35 @@ public:
       return false;
 
     m_in_pipe.write(byte);
+    if (byte == protocol_bytes::frame_boundary)
+      dispatch_frames();
     return true;
   }
 
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Sets how long recieve_frame() waits, in ticks.
+   *
+   * @details    2000 by default. Set it before the io is used from another
+   *             thread.
+   */
+  void   set_response_timeout(const size_t timeout) noexcept { m_response_timeout = timeout; }
+  size_t response_timeout(void) const noexcept { return m_response_timeout; }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Sets the control field format frames are encoded and decoded
+   *             with.
+   *
+   * @details    Basic by default. Sessions set it when the link is set up
+   *             with SNRME or SABME, and back when it is set up with SNRM or
+   *             SABM.
+   */
+  void         set_control_field(const ControlField field) noexcept { m_control_field = field; }
+  ControlField control_field(void) const noexcept { return m_control_field; }
+
   /*----------  Public interface  ----------*/
   virtual size_t get_tick(void) const   = 0;
   virtual bool   handle_out(void)       = 0;
@@ -133,10 +377,66 @@ public:
   virtual void   sleep(const size_t ms) = 0;
 
 private:
+  /**
+   * @brief      Waits for a frame and passes it to decoder(first, second),
+   *             which returns true if the frame is valid.
+   */
+  template <typename decoder_t>
+  bool recieve(decoder_t&& decoder)
+  {
+    const auto start_tick = get_tick();
+
+    for (;;)
+    {
+      if (m_in_pipe.frame_count())
+      {
+        bool valid = false;
+        m_in_pipe.read_frame([&](span<const uint8_t> first, span<const uint8_t> second) { valid = decoder(first, second); });
+        if (valid)
+        {
+          return true;
+        }
+        continue;
+      }
+
+      // One reading of the tick, a second could be past the deadline.
+      const auto elapsed = get_elapsed(start_tick);
+      if (elapsed >= m_response_timeout)
+      {
+        // Clear any partial frames since we dont know if the timeout has
+        // occured mid frame.
+        m_in_pipe.clear_partial();
+        return false;
+      }
+
+      // Sleep until the pipe signals a complete frame rather than polling.
+      m_in_pipe.wait_for_frame(m_response_timeout - elapsed);
+    }
+  }
+
 protected:
-  FramePipe    m_out_pipe; //< Contains outgoing data.
-  FramePipe    m_in_pipe;  //< Contains incoming data.
-  const size_t m_response_timeout = 2000;
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Called after a frame has been queued in the out pipe.
+   *
+   * @details    Does nothing by default, io implementations which sleep until
+   *             there is something to send override it to wake up.
+   */
+  virtual void out_queued(void) {}
+
+  pipe_t m_out_pipe;                //< Contains outgoing data.
+  pipe_t m_in_pipe;                 //< Contains incoming data.
+  size_t m_response_timeout = 2000; //< Ticks recieve_frame() waits.
+
+private:
+  std::atomic<ControlField> m_control_field{ControlField::Basic}; //! See set_control_field().
+  std::atomic<bool>         m_subscribed{false};                   //! Set once the subscriber below may be used.
+  frame_handler             m_frame_handler;                       //! Subscriber, see on_frame().
+  executor                  m_executor;                            //! Runs the subscriber when set.
+  std::vector<uint8_t>      m_dispatch_storage;                    //! Decode buffer for dispatch_frames().
 };
 
+using base_io = basic_io<fcs16>; //! IO using the default 16 bit FCS.
+
 } // namespace hdlc
@@ -0,0 +1,125 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+
+#include "types.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace hdlc
+{
+namespace pool
+{
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Pool counters.
+ */
+struct statistics
+{
+  size_t hits     = 0; //! Allocations served from a free list.
+  size_t misses   = 0; //! Allocations which went to the heap.
+  size_t releases = 0; //! Blocks returned to the heap because the free list was full or the block too large.
+};
+
+constexpr size_t smallest_class = 32;   //! Smallest block handed out.
+constexpr size_t largest_class  = 4096; //! Larger requests bypass the pool.
+constexpr size_t class_count    = 8;    //! 32, 64, ... 4096 bytes.
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Returns the size class index of a request.
+ *
+ * @return     Index in [0, class_count), or class_count if the request is
+ *             larger than largest_class.
+ */
+constexpr size_t size_class(const size_t size) noexcept
+{
+  return (size <= smallest_class) ? 0 : (size > largest_class) ? class_count : 1 + size_class((size + 1) >> 1);
+}
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Allocates a block of at least size bytes.
+ *
+ * @details    Blocks come from a free list owned by the calling thread, so
+ *             no lock is taken. The free list is refilled from the heap when
+ *             it runs dry.
+ */
+void* allocate(const size_t size);
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Returns a block to the calling thread's free list.
+ *
+ * @param      block  The block
+ * @param[in]  size   The size it was allocated with.
+ *
+ * @details    A block may be returned on a different thread than the one it
+ *             was allocated on. Each free list keeps at most
+ *             HDLC_POOL_MAX_FREE blocks, the rest go back to the heap.
+ */
+void deallocate(void* block, const size_t size) noexcept;
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Counters of the calling thread.
+ */
+statistics thread_statistics(void) noexcept;
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Resets the counters of the calling thread.
+ */
+void reset_thread_statistics(void) noexcept;
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Standard allocator drawing from the pool.
+ *
+ * @tparam     T     Value type
+ */
+template <typename T>
+class allocator
+{
+public:
+  using value_type = T;
+
+  allocator() noexcept = default;
+  template <typename U>
+  allocator(const allocator<U>&) noexcept
+  {
+  }
+
+  T*   allocate(const size_t count) { return static_cast<T*>(pool::allocate(count * sizeof(T))); }
+  void deallocate(T* block, const size_t count) noexcept { pool::deallocate(block, count * sizeof(T)); }
+
+  template <typename U>
+  bool operator==(const allocator<U>&) const noexcept
+  {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const allocator<U>&) const noexcept
+  {
+    return false;
+  }
+};
+
+using buffer = std::vector<uint8_t, allocator<uint8_t>>; //! Byte buffer drawing from the pool.
+
+} // namespace pool
+} // namespace hdlc
@@ -30,13 +30,13 @@ public:
   RandomFrameFactory()  = delete;
   ~RandomFrameFactory() = delete;
 
-  static Frame make_inforamtion(const size_t max_payload_length = 512)
+  static Frame make_inforamtion(const size_t max_payload_length = 512, const ControlField field = ControlField::Basic)
   {
     std::vector<uint8_t> payload     = get_random_payload(max_payload_length);
     const bool           poll        = (get_random_byte() & 1) ? true : false;
     const auto           address     = get_random_byte();
-    const auto           recieve_seq = get_random_byte();
-    const auto           send_seq    = get_random_byte();
+    const auto           recieve_seq = get_random_sequence(field);
+    const auto           send_seq    = get_random_sequence(field);
 
     return Frame(payload, Frame::Type::I, poll, address, recieve_seq, send_seq);
   }
@@ -46,9 +46,10 @@ public:
     static const Frame::Type frame_type[] = {Frame::Type::UI,      Frame::Type::SABM,    Frame::Type::UA,  Frame::Type::SARM_DM,
                                              Frame::Type::SIM_RIM, Frame::Type::DISC_RD, Frame::Type::UP,  Frame::Type::RSET,
                                              Frame::Type::XID,     Frame::Type::FRMR,    Frame::Type::NR0, Frame::Type::NR2,
-                                             Frame::Type::SNRM,    Frame::Type::NR1,     Frame::Type::NR3, Frame::Type::TEST};
+                                             Frame::Type::SNRM,    Frame::Type::NR1,     Frame::Type::NR3, Frame::Type::TEST,
+                                             Frame::Type::SARME,   Frame::Type::SNRME,   Frame::Type::SABME};
 
-    static std::uniform_int_distribution<uint8_t> distribution(0, 15);
+    static std::uniform_int_distribution<uint8_t> distribution(0, 18);
 
     const bool poll        = (get_random_byte() & 1) ? true : false;
     const auto address     = get_random_byte();
@@ -58,7 +59,7 @@ public:
     return Frame(type, poll, address, recieve_seq);
   }
 
-  static Frame make_supervisory(void)
+  static Frame make_supervisory(const ControlField field = ControlField::Basic)
   {
     static const Frame::Type frame_type[] = {
         Frame::Type::RR,
@@ -69,19 +70,19 @@ public:
     static std::uniform_int_distribution<uint8_t> distribution(0, 3);
     const bool                                    poll        = (get_random_byte() & 1) ? true : false;
     const auto                                    address     = get_random_byte();
-    const auto                                    recieve_seq = get_random_byte();
+    const auto                                    recieve_seq = get_random_sequence(field);
     const auto                                    type        = frame_type[distribution(m_generator)];
     return Frame(type, poll, address, recieve_seq);
   }
 
-  static Frame make(void)
+  static Frame make(const ControlField field = ControlField::Basic)
   {
     static std::uniform_int_distribution<uint8_t> distribution(0, 2);
     switch (distribution(m_generator))
     {
-    case 0: return make_inforamtion();
+    case 0: return make_inforamtion(512, field);
     case 1: return make_unnumbered();
-    default: return make_supervisory();
+    default: return make_supervisory(field);
     }
   }
 
@@ -98,6 +99,14 @@ public:
     return distribution(m_generator);
   }
 
+  /**
+   * @brief      Sequence number in the range the control field can carry.
+   */
+  static uint8_t get_random_sequence(const ControlField field = ControlField::Basic)
+  {
+    return get_random_byte() % (field == ControlField::Extended ? 128 : 8);
+  }
+
   static uint8_t get_random_byte(void)
   {
     static std::uniform_int_distribution<uint8_t> m_byte_distribution(0, 0xFF);
@@ -0,0 +1,189 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+
+#include "types.h"
+
+#if HDLC_USE_EPOLL
+
+#include <atomic>
+#include <stddef.h>
+#include <vector>
+
+namespace hdlc
+{
+
+class reactor;
+class reactor_link;
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Identifies which descriptor of a link an epoll event is for.
+ */
+struct reactor_handle
+{
+  reactor_link* link;
+  bool          out; //! true for the wake up descriptor, false for the link itself.
+};
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Something a reactor can drive.
+ *
+ * @details    A link is polled through two descriptors, the link itself and
+ *             a descriptor which becomes readable when output has been
+ *             queued. See basic_fd_io.
+ */
+class reactor_link
+{
+public:
+  reactor_link() : m_in_handle{this, false}, m_out_handle{this, true} {}
+  reactor_link(const reactor_link&) = delete;
+  reactor_link& operator=(const reactor_link&) = delete;
+  virtual ~reactor_link() {}
+
+  /**
+   * @brief      Descriptor the link reads from and writes to.
+   */
+  virtual int native_handle(void) const = 0;
+
+  /**
+   * @brief      Descriptor which is readable while output is queued, -1 if
+   *             the link has none.
+   */
+  virtual int event_handle(void) const = 0;
+
+  /**
+   * @brief      Reads what is available, false if the link has closed.
+   */
+  virtual bool on_readable(void) = 0;
+
+  /**
+   * @brief      Writes what it can, true once all output has been written.
+   */
+  virtual bool on_writable(void) = 0;
+
+  /**
+   * @brief      true while there is no room to read into, the reactor stops
+   *             polling for input until there is.
+   */
+  virtual bool in_full(void) = 0;
+
+private:
+  friend class reactor;
+
+  reactor*       m_reactor = nullptr; //! Set while registered.
+  reactor_handle m_in_handle;         //! epoll data of native_handle().
+  reactor_handle m_out_handle;        //! epoll data of event_handle().
+  bool           m_want_in  = true;   //! Polling native_handle() for input, false while in_full().
+  bool           m_want_out = false;  //! Waiting for native_handle() to become writable.
+  bool           m_armed    = false;  //! native_handle() is in the epoll set.
+};
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Drives any number of links from one thread.
+ *
+ * @details    Every link is registered with a single epoll instance. When a
+ *             link becomes readable everything available is read into its
+ *             in pipe in bulk, when output is queued the out pipe is written
+ *             until the descriptor would block, the reactor then waits for it
+ *             to become writable again. The number of threads does not depend
+ *             on the number of links.
+ *
+ *             A link whose in pipe is full is no longer polled for input, as
+ *             epoll would otherwise report it readable over and over. While
+ *             any link is stalled the reactor wakes every stall_retry_ms to
+ *             see whether its consumer has made room.
+ *
+ *             Links which close are removed. Links must outlive their
+ *             registration, remove them from the thread running the reactor
+ *             or once it has stopped.
+ */
+class reactor
+{
+public:
+  static constexpr int stall_retry_ms = 10; //! Longest wait while a link's in pipe is full.
+
+  reactor();
+  ~reactor();
+  reactor(const reactor&) = delete;
+  reactor& operator=(const reactor&) = delete;
+
+  /**
+   * @brief      false if the epoll instance could not be created.
+   */
+  bool is_open(void) const noexcept { return m_epoll >= 0; }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Starts polling a link.
+   *
+   * @return     true if registered.
+   */
+  bool add(reactor_link& link);
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Stops polling a link.
+   *
+   * @return     true if it was registered.
+   */
+  bool remove(reactor_link& link);
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Waits for events and handles them.
+   *
+   * @param[in]  timeout_ms  Maximum wait, -1 waits until an event arrives.
+   *                         Shortened to stall_retry_ms while a link is
+   *                         stalled.
+   *
+   * @return     Number of events handled.
+   */
+  size_t run_once(const int timeout_ms);
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Handles events until stop() is called.
+   */
+  void run(void);
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Makes run() return, may be called from any thread.
+   */
+  void stop(void);
+
+  size_t size(void) const noexcept { return m_links; }
+
+private:
+  void flush(reactor_link& link);
+  bool watch_out(reactor_link& link, const bool want_out);
+  void stall(reactor_link& link);
+  void resume_stalled(void);
+  bool arm(reactor_link& link);
+
+  int                        m_epoll = -1;      //! epoll instance.
+  int                        m_stop  = -1;      //! eventfd written by stop().
+  std::atomic<bool>          m_stopping{false}; //! Set by stop().
+  size_t                     m_links = 0;       //! Registered links.
+  std::vector<reactor_link*> m_stalled;         //! Links not polled for input because their in pipe is full.
+};
+
+} // namespace hdlc
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+
+#include "span.h"
+#include "types.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace hdlc
+{
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Ring storage on the heap, the default for BasicFramePipe.
+ *
+ * @details    Data which wraps the end of the storage is split in two.
+ */
+class heap_ring
+{
+public:
+  explicit heap_ring(const size_t size) : m_data(size) {}
+
+  uint8_t*       data(void) noexcept { return m_data.data(); }
+  const uint8_t* data(void) const noexcept { return m_data.data(); }
+  size_t         size(void) const noexcept { return m_data.size(); }
+  uint8_t&       operator[](const size_t index) noexcept { return m_data[index]; }
+
+  /**
+   * @brief      true if the storage is mapped twice back to back.
+   */
+  constexpr bool mirrored(void) const noexcept { return false; }
+
+  /**
+   * @brief      All memory backing the ring.
+   */
+  span<uint8_t> mapping(void) noexcept { return span<uint8_t>(m_data.data(), m_data.size()); }
+
+private:
+  std::vector<uint8_t> m_data;
+};
+
+#if HDLC_USE_MIRRORED_RING
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Ring storage whose pages are mapped twice, back to back.
+ *
+ * @details    Byte i and byte i + size() are the same memory, so anything
+ *             up to size() bytes long starting anywhere in the ring can be
+ *             used as one contiguous range, also across the wrap. The size
+ *             is rounded up to a whole number of pages.
+ *
+ *             If the memory cannot be mapped twice the ring falls back to
+ *             the heap and mirrored() returns false.
+ */
+class mirrored_ring
+{
+public:
+  explicit mirrored_ring(const size_t size);
+  ~mirrored_ring();
+  mirrored_ring(const mirrored_ring&) = delete;
+  mirrored_ring& operator=(const mirrored_ring&) = delete;
+
+  uint8_t*       data(void) noexcept { return m_data; }
+  const uint8_t* data(void) const noexcept { return m_data; }
+  size_t         size(void) const noexcept { return m_size; }
+  uint8_t&       operator[](const size_t index) noexcept { return m_data[index]; }
+
+  bool mirrored(void) const noexcept { return m_mirrored; }
+
+  /**
+   * @brief      All memory backing the ring, both copies when mirrored.
+   */
+  span<uint8_t> mapping(void) noexcept { return span<uint8_t>(m_data, m_mirrored ? 2 * m_size : m_size); }
+
+  /**
+   * @brief      Granularity of the mapping, sizes are rounded up to it.
+   */
+  static size_t page_size(void) noexcept;
+
+private:
+  uint8_t*             m_data     = nullptr; //! Start of the first copy.
+  size_t               m_size     = 0;       //! Size of one copy.
+  bool                 m_mirrored = false;   //! Both copies are mapped.
+  std::vector<uint8_t> m_fallback;           //! Storage when the mapping failed.
+};
+#endif
+
+} // namespace hdlc
@@ -7,9 +7,15 @@
 
 #pragma once
 
+#include "crc.h"
+#include "fcs.h"
 #include "frame.h"
+#include "frame_view.h"
+#include "span.h"
 #include "types.h"
-#include <boost/crc.hpp>
+
+#include <memory>
+#include <vector>
 
 namespace hdlc
 {
@@ -19,27 +25,214 @@ namespace hdlc
  * @date       28-Feb-2019
  * @brief      Class for serializing/deserializing frames.
  *
+ * @tparam     fcs_t  Frame check sequence policy, see fcs.h
+ *
  * @details    Converts frame objects to char vectors and vice-versa
+ *
+ *             The control field is one byte unless ControlField::Extended
+ *             is passed, then I and S frames have a two byte control field
+ *             with 7 bit sequence numbers. U frames keep one byte in both.
+ *             Nothing in the frame tells the two apart, both ends use what
+ *             the link was set up with.
  */
-class FrameSerializer
+template <typename fcs_t>
+class BasicFrameSerializer
 {
 public:
-  static std::vector<uint8_t> serialize(const Frame &frame);
-  static std::vector<uint8_t> escape(const std::vector<uint8_t> &frame);
-  static Frame                deserialize(const std::vector<uint8_t> &buffer);
-  static std::vector<uint8_t> descape(const std::vector<uint8_t> &buffer);
+  using fcs_type      = fcs_t;
+  using checksum_type = typename fcs_t::value_type;
+
+  static constexpr size_t frame_min_size = fcs_t::frame_min_size;
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Packs a frame, adds the FCS and both boundaries.
+   *
+   * @tparam     alloc_t  Allocator of the returned buffer, pool::allocator
+   *                      draws from the per thread pool.
+   */
+  template <typename alloc_t = std::allocator<uint8_t>>
+  static std::vector<uint8_t, alloc_t> serialize(const Frame &frame, const ControlField field = ControlField::Basic)
+  {
+    std::vector<uint8_t, alloc_t> raw(serialized_size(frame, field));
+    serialize_into(frame, field, raw.data());
+    return raw;
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Byte stuffs everything between the boundaries.
+   */
+  template <typename alloc_t>
+  static std::vector<uint8_t, alloc_t> escape(const std::vector<uint8_t, alloc_t> &frame)
+  {
+    std::vector<uint8_t, alloc_t> escaped(escaped_size(frame));
+    escape_into(frame, escaped.data());
+    return escaped;
+  }
+
+  template <typename alloc_t>
+  static Frame deserialize(const std::vector<uint8_t, alloc_t> &buffer, const ControlField field = ControlField::Basic)
+  {
+    return Frame(parse(span<const uint8_t>(buffer.data(), buffer.size()), field));
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Removes byte stuffing.
+   */
+  template <typename alloc_t>
+  static std::vector<uint8_t, alloc_t> descape(const std::vector<uint8_t, alloc_t> &buffer)
+  {
+    // Escapes only ever shrink the buffer.
+    std::vector<uint8_t, alloc_t> descaped(buffer.size());
+    descaped.resize(descape_into(buffer, descaped.data()));
+    return descaped;
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Serializes, checksums and escapes a frame in a single pass.
+   *
+   * @param[in]  frame   The frame, a Frame or a FrameView.
+   * @param[in]  first   Output space
+   * @param[in]  second  Optional continuation of the output space, used when
+   *                     writing into a ring buffer that wraps.
+   * @param[in]  field   Control field format of the link.
+   *
+   * @return     Number of bytes written or 0 if the frame does not fit.
+   *
+   * @details    Produces the same bytes as escape(serialize(frame)) without
+   *             allocating. On failure the contents of the output space are
+   *             unspecified.
+   */
+  static size_t encode(const FrameView &frame, span<uint8_t> first, span<uint8_t> second = span<uint8_t>(),
+                       const ControlField field = ControlField::Basic);
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Same as above with the payload gathered from several spans.
+   *
+   * @param[in]  header   Type, address, poll and sequence numbers of the
+   *                      frame, its own payload is ignored.
+   * @param[in]  payload  Payload parts, sent back to back in order like an
+   *                      iovec. Ignored for frame types without a payload.
+   * @param[in]  first    Output space
+   * @param[in]  second   Optional continuation of the output space.
+   * @param[in]  field    Control field format of the link.
+   *
+   * @return     Number of bytes written or 0 if the frame does not fit.
+   *
+   * @details    The parts are checksummed and escaped straight into the
+   *             output, so the payload is never copied into a Frame first.
+   */
+  static size_t encode(const FrameView &header, span<const span<const uint8_t>> payload, span<uint8_t> first,
+                       span<uint8_t> second = span<uint8_t>(), const ControlField field = ControlField::Basic);
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Removes escapes, verifies the FCS and parses a frame in a
+   *             single pass.
+   *
+   * @param[in]  first   Escaped frame bytes including both boundaries
+   * @param[in]  second  Optional continuation of the frame bytes, used when
+   *                     the frame wraps around a ring buffer.
+   * @param[in]  field   Control field format of the link.
+   *
+   * @return     The frame, or an empty frame if it is invalid.
+   *
+   * @details    Equivalent to deserialize(descape(bytes)). Escapes are
+   *             removed straight into the payload of the returned frame and
+   *             the FCS is computed on the way, so the bytes are only read
+   *             once.
+   */
+  static Frame decode(span<const uint8_t> first, span<const uint8_t> second = span<const uint8_t>(),
+                      const ControlField field = ControlField::Basic);
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Parses an unescaped frame in place.
+   *
+   * @param[in]  raw    Frame bytes including both boundaries, as returned by
+   *                    serialize() or descape().
+   * @param[in]  field  Control field format of the link.
+   *
+   * @return     View into raw, or an empty view if the frame is invalid.
+   *
+   * @details    Same checks as deserialize() but nothing is copied, the
+   *             payload of the view points into raw.
+   */
+  static FrameView parse(span<const uint8_t> raw, const ControlField field = ControlField::Basic);
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Decodes an escaped frame into a view.
+   *
+   * @param[in]  first    Escaped frame bytes including both boundaries
+   * @param[in]  second   Continuation of the frame bytes after a wrap, may
+   *                      be empty.
+   * @param[in]  storage  Where the unescaped frame is written, needs room for
+   *                      first.size() + second.size() bytes. Escapes only
+   *                      shrink a frame so storage may start at first.
+   * @param[in]  field    Control field format of the link.
+   *
+   * @return     View into storage, or an empty view if the frame is invalid
+   *             or storage is too small.
+   */
+  static FrameView decode_view(span<const uint8_t> first, span<const uint8_t> second, span<uint8_t> storage,
+                               const ControlField field = ControlField::Basic);
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Decodes an escaped frame in place.
+   *
+   * @param[in]  bytes  Escaped frame bytes including both boundaries, they
+   *                    are overwritten by the unescaped frame.
+   * @param[in]  field  Control field format of the link.
+   *
+   * @return     View into bytes, or an empty view if the frame is invalid.
+   */
+  static FrameView decode_view(span<uint8_t> bytes, const ControlField field = ControlField::Basic)
+  {
+    return decode_view(bytes, span<const uint8_t>(), bytes, field);
+  }
 
   template <typename iterator_t>
-  static auto checksum(iterator_t begin, iterator_t end);
-  static auto checksum(std::vector<uint8_t> &frame);
-  static void append_checksum(std::vector<uint8_t> &buffer);
+  static checksum_type checksum(iterator_t begin, iterator_t end);
+  static checksum_type checksum(std::vector<uint8_t> &frame);
+  static void          append_checksum(std::vector<uint8_t> &buffer);
   template <typename iterator_t>
   static bool is_checksum_valid(iterator_t begin, iterator_t end);
   static bool is_checksum_valid(std::vector<uint8_t> &buffer);
 
 private:
-  static auto                 get_frame_type(const uint8_t control);
-  static boost::crc_basic<16> crc_ccitt;
+  static size_t    serialized_size(const Frame &frame, const ControlField field);
+  static void      serialize_into(const Frame &frame, const ControlField field, uint8_t *out);
+  static size_t    escaped_size(span<const uint8_t> frame);
+  static void      escape_into(span<const uint8_t> frame, uint8_t *out);
+  static size_t    descape_into(span<const uint8_t> buffer, uint8_t *out);
+  static auto      get_frame_type(const uint8_t control);
+  static size_t    put_control(const FrameView &frame, const ControlField field, uint8_t *out);
+  static Frame     make_frame(const uint8_t address, span<const uint8_t> control, Frame::payload_type &&payload);
+  static FrameView make_view(const uint8_t address, span<const uint8_t> control, span<const uint8_t> payload);
 };
 
+template <typename fcs_t>
+constexpr size_t BasicFrameSerializer<fcs_t>::frame_min_size;
+
+using FrameSerializer   = BasicFrameSerializer<fcs16>; //! Serializer using the 16 bit FCS.
+using FrameSerializer32 = BasicFrameSerializer<fcs32>; //! Serializer using the 32 bit FCS.
+
+extern template class BasicFrameSerializer<fcs16>;
+extern template class BasicFrameSerializer<fcs32>;
+
 } // namespace hdlc
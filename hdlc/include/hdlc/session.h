@@ -27,6 +27,18 @@ public:
   Session(const uint8_t primary, const uint8_t secondary) : m_primary(primary), m_secondary(secondary) {}
   virtual ~Session() {}
 
+  static constexpr uint8_t basic_modulus    = 8;   //! Sequence numbers count modulo this with the basic control field.
+  static constexpr uint8_t extended_modulus = 128; //! And modulo this with the extended one.
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Control field format the link was set up with and the
+   *             sequence number modulus that goes with it.
+   */
+  ControlField control_field() const noexcept { return m_control_field; }
+  uint8_t      modulus() const noexcept { return m_control_field == ControlField::Extended ? extended_modulus : basic_modulus; }
+
   uint8_t          primary() const noexcept { return m_primary; }
   uint8_t          secondary() const noexcept { return m_secondary; }
   void             disconnect() { set_status(ConnectionStatus::Disconnected); }
@@ -39,19 +51,48 @@ public:
     case ConnectionStatus::Connecting:
     case ConnectionStatus::Connected: m_status = status; break;
     default:
-      m_status      = ConnectionStatus::Disconnected;
-      m_send_seq    = 0;
-      m_recieve_seq = 0;
+      m_status = ConnectionStatus::Disconnected;
+      reset_sequence();
       break;
     }
   }
 
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Resets the sequence state, done whenever a link is set up.
+   */
+  void reset_sequence() noexcept
+  {
+    m_send_seq    = 0;
+    m_ack_seq     = 0;
+    m_recieve_seq = 0;
+  }
+
 protected:
+  uint8_t next(const uint8_t seq) const noexcept { return static_cast<uint8_t>((seq + 1) % modulus()); }
+
+  /**
+   * @brief      Number of steps from one sequence number forward to another.
+   */
+  uint8_t distance(const uint8_t from, const uint8_t to) const noexcept
+  {
+    return static_cast<uint8_t>((to + modulus() - from) % modulus());
+  }
+
+  /**
+   * @brief      Switches the sequence numbering, only while the link is being
+   *             set up.
+   */
+  void set_control_field(const ControlField field) noexcept { m_control_field = field; }
+
   uint8_t          m_primary;
   uint8_t          m_secondary;
-  ConnectionStatus m_status      = ConnectionStatus::Disconnected;
-  uint8_t          m_send_seq    = 0;
-  uint8_t          m_recieve_seq = 0;
+  ConnectionStatus m_status        = ConnectionStatus::Disconnected;
+  uint8_t          m_send_seq      = 0;                   //! V(S), N(S) of the next I-frame sent.
+  uint8_t          m_ack_seq       = 0;                   //! V(A), N(S) of the oldest I-frame not yet acknowledged.
+  uint8_t          m_recieve_seq   = 0;                   //! V(R), N(S) expected in the next I-frame received.
+  ControlField     m_control_field = ControlField::Basic; //! Set up by SNRM and SABM, or SNRME and SABME.
 };
 } // namespace session
 } // namespace hdlc
@@ -0,0 +1,207 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+namespace hdlc
+{
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Byte buffer with inline storage.
+ *
+ * @tparam     inline_size  Number of bytes stored inside the object.
+ * @tparam     alloc_t      Stateless allocator for buffers which do not fit
+ *                          inline.
+ *
+ * @details    Behaves like a minimal std::vector<uint8_t>. Up to inline_size
+ *             bytes are kept inside the object so small buffers never touch
+ *             the heap, larger ones are moved to a heap block. Moving a heap
+ *             buffer steals the block, moving or copying an inline buffer
+ *             copies only the bytes in use.
+ */
+template <size_t inline_size, typename alloc_t = std::allocator<uint8_t>>
+class small_buffer
+{
+public:
+  using value_type     = uint8_t;
+  using size_type      = size_t;
+  using iterator       = uint8_t*;
+  using const_iterator = const uint8_t*;
+
+  small_buffer() noexcept {}
+
+  template <typename iter_t>
+  small_buffer(iter_t begin, iter_t end)
+  {
+    assign(begin, end);
+  }
+
+  small_buffer(const small_buffer& other) { assign(other.begin(), other.end()); }
+
+  small_buffer(small_buffer&& other) noexcept { take(other); }
+
+  ~small_buffer() { release(); }
+
+  small_buffer& operator=(const small_buffer& other)
+  {
+    if (this != &other)
+      assign(other.begin(), other.end());
+    return *this;
+  }
+
+  small_buffer& operator=(small_buffer&& other) noexcept
+  {
+    if (this != &other)
+    {
+      release();
+      take(other);
+    }
+    return *this;
+  }
+
+  uint8_t*       data() noexcept { return m_data; }
+  const uint8_t* data() const noexcept { return m_data; }
+  size_t         size() const noexcept { return m_size; }
+  size_t         capacity() const noexcept { return m_capacity; }
+  bool           empty() const noexcept { return m_size == 0; }
+  bool           is_inline() const noexcept { return m_data == m_inline; }
+
+  iterator       begin() noexcept { return m_data; }
+  iterator       end() noexcept { return m_data + m_size; }
+  const_iterator begin() const noexcept { return m_data; }
+  const_iterator end() const noexcept { return m_data + m_size; }
+
+  uint8_t&       operator[](const size_t i) noexcept { return m_data[i]; }
+  const uint8_t& operator[](const size_t i) const noexcept { return m_data[i]; }
+
+  void clear() noexcept { m_size = 0; }
+
+  /**
+   * @brief      Makes room for at least size bytes, existing bytes are kept.
+   */
+  void reserve(const size_t size)
+  {
+    if (size <= m_capacity)
+      return;
+
+    const auto capacity = std::max(size, 2 * m_capacity);
+    auto       block    = alloc_t().allocate(capacity);
+    memcpy(block, m_data, m_size);
+    release();
+    m_data     = block;
+    m_capacity = capacity;
+  }
+
+  void resize(const size_t size)
+  {
+    reserve(size);
+    if (size > m_size)
+      memset(m_data + m_size, 0, size - m_size);
+    m_size = size;
+  }
+
+  void push_back(const uint8_t byte)
+  {
+    reserve(m_size + 1);
+    m_data[m_size++] = byte;
+  }
+
+  template <typename iter_t>
+  void assign(iter_t begin, iter_t end)
+  {
+    clear();
+    append(begin, end);
+  }
+
+  template <typename iter_t>
+  void append(iter_t begin, iter_t end)
+  {
+    const auto count = static_cast<size_t>(std::distance(begin, end));
+    reserve(m_size + count);
+    std::copy(begin, end, m_data + m_size);
+    m_size += count;
+  }
+
+private:
+  void release() noexcept
+  {
+    if (!is_inline())
+      alloc_t().deallocate(m_data, m_capacity);
+    m_data     = m_inline;
+    m_capacity = inline_size;
+  }
+
+  void take(small_buffer& other) noexcept
+  {
+    if (other.is_inline())
+    {
+      memcpy(m_inline, other.m_inline, other.m_size);
+    }
+    else
+    {
+      m_data       = other.m_data;
+      m_capacity   = other.m_capacity;
+      other.m_data = other.m_inline;
+    }
+    m_size           = other.m_size;
+    other.m_size     = 0;
+    other.m_capacity = inline_size;
+  }
+
+  uint8_t* m_data     = m_inline;    //! Points at m_inline or a heap block.
+  size_t   m_size     = 0;           //! Bytes in use.
+  size_t   m_capacity = inline_size; //! Bytes available at m_data.
+  uint8_t  m_inline[inline_size];    //! Inline storage, left uninitialised.
+};
+
+template <size_t inline_size, typename alloc_t>
+bool operator==(const small_buffer<inline_size, alloc_t>& a, const small_buffer<inline_size, alloc_t>& b)
+{
+  return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+template <size_t inline_size, typename alloc_t, typename vector_alloc_t>
+bool operator==(const small_buffer<inline_size, alloc_t>& a, const std::vector<uint8_t, vector_alloc_t>& b)
+{
+  return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+template <size_t inline_size, typename alloc_t, typename vector_alloc_t>
+bool operator==(const std::vector<uint8_t, vector_alloc_t>& a, const small_buffer<inline_size, alloc_t>& b)
+{
+  return b == a;
+}
+
+template <size_t inline_size, typename alloc_t>
+bool operator!=(const small_buffer<inline_size, alloc_t>& a, const small_buffer<inline_size, alloc_t>& b)
+{
+  return !(a == b);
+}
+
+template <size_t inline_size, typename alloc_t, typename vector_alloc_t>
+bool operator!=(const small_buffer<inline_size, alloc_t>& a, const std::vector<uint8_t, vector_alloc_t>& b)
+{
+  return !(a == b);
+}
+
+template <size_t inline_size, typename alloc_t, typename vector_alloc_t>
+bool operator!=(const std::vector<uint8_t, vector_alloc_t>& a, const small_buffer<inline_size, alloc_t>& b)
+{
+  return !(a == b);
+}
+
+} // namespace hdlc
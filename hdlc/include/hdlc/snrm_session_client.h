@@ -10,7 +10,15 @@
 #include "io.h"
 #include "session.h"
 #include "types.h"
+
+#include "stream_helper.h"
+
+#include <atomic>
+#include <functional>
+#include <iostream>
 #include <map>
+#include <utility>
+#include <vector>
 
 namespace hdlc
 {
@@ -26,7 +34,26 @@ namespace snrm
  *
  * @tparam     io_t  IO type
  *
- * @details
+ * @details    Information frames are passed to the handler installed for
+ *             Frame::Type::I in sequence. A frame out of sequence is
+ *             dropped along with everything after it until the missing
+ *             frame is sent again. Being the secondary it only answers
+ *             polls, with the handler's information frame or with RR, or
+ *             REJ while frames are missing, carrying the next N(S) it
+ *             expects.
+ *
+ *             With selective reject enabled frames after a gap are held
+ *             instead and each missing frame is requested with SREJ, so
+ *             only the lost frames are sent again.
+ *
+ *             While busy, set with set_busy() or by the handler returning
+ *             StatusError::Busy, information frames are dropped and polls
+ *             are answered with RNR so the master stops sending. An N(R)
+ *             acknowledging a response which was never sent drops the link
+ *             with StatusError::InvalidSequence.
+ *
+ *             The control field follows the master, SNRME sets up a link
+ *             with the extended field and sequence numbers modulo 128.
  */
 template <typename io_t>
 class Client : public Session
@@ -35,10 +62,14 @@ class Client : public Session
 public:
   using handler_t = std::function<StatusError(Client<io_t>&, const Frame&, Frame&)>;
 
-  Client(io_t& io, const uint paddr = 0xFF, const uint8_t saddr = 0xFF) : Session(paddr, saddr), m_io(io)
+  Client(io_t& io, const uint paddr = 0xFF, const uint8_t saddr = 0xFF) : Session(paddr, saddr), m_io(io), m_held(extended_modulus, Frame(Frame::Type::UNSET))
   {
     install_handler(Frame::Type::SNRM, default_snrm_handler);
+    install_handler(Frame::Type::SNRME, default_snrm_handler);
     install_handler(Frame::Type::TEST, default_test_handler);
+    install_handler(Frame::Type::RR, default_status_handler);
+    install_handler(Frame::Type::RNR, default_status_handler);
+    install_handler(Frame::Type::REJ, default_status_handler);
   }
   virtual ~Client() {}
 
@@ -48,11 +79,19 @@ public:
   StatusError handle(const Frame& cmd, Frame& resp)
   {
     // If we are disconnected then send back SARM_DM unless the frame is a setup frame.
-    if (!connected() && cmd.get_type() != Frame::Type::SNRM)
+    if (!connected() && cmd.get_type() != Frame::Type::SNRM && cmd.get_type() != Frame::Type::SNRME)
     {
       resp = Frame(Frame::Type::SARM_DM, true, secondary());
       return StatusError::Success;
     }
+    else if ((cmd.is_information() || cmd.is_supervisory()) && !acknowledge(cmd))
+    {
+      return StatusError::InvalidSequence;
+    }
+    else if (cmd.is_information())
+    {
+      return handle_information(cmd, resp);
+    }
     else if (m_handler_map.count(cmd.get_type()))
     {
       return m_handler_map[cmd.get_type()](*this, cmd, resp);
@@ -103,8 +142,15 @@ public:
 
   static StatusError default_snrm_handler(Client<io_t>& session, const Frame& cmd, Frame& resp)
   {
+    // Frames after the UA are in the new format.
+    const auto field = (cmd.get_type() == Frame::Type::SNRME) ? ControlField::Extended : ControlField::Basic;
+    session.set_control_field(field);
+    session.m_io.set_control_field(field);
     session.set_status(ConnectionStatus::Connected);
-    (void)cmd; // Unused.
+    session.reset_sequence();
+    session.m_rejecting = false;
+    session.m_refused   = false;
+    session.release_held();
     resp = Frame(Frame::Type::UA, true, session.secondary());
     return StatusError::Success;
   }
@@ -117,9 +163,200 @@ public:
     return StatusError::Success;
   }
 
+  /* Answers a supervisory poll with the receive state. */
+  static StatusError default_status_handler(Client<io_t>& session, const Frame& cmd, Frame& resp)
+  {
+    if (cmd.is_poll())
+      resp = session.poll_response();
+    return StatusError::Success;
+  }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Holds frames received after a gap and requests the missing
+   *             ones with SREJ instead of rejecting everything after the
+   *             gap.
+   *
+   * @details    A held frame cannot be told apart from a repeated old one
+   *             unless the master keeps its window at most modulus() / 2.
+   */
+  void set_selective_reject(const bool enable)
+  {
+    m_selective = enable;
+    release_held();
+  }
+  bool selective_reject(void) const noexcept { return m_selective; }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Sets the local busy condition, for when whatever consumes
+   *             the information frames falls behind.
+   *
+   * @details    May be called from any thread. Frames dropped while busy
+   *             are sent again by the master once polls are answered with RR
+   *             again. A handler returning StatusError::Busy refuses just the
+   *             one frame until the next poll.
+   */
+  void set_busy(const bool busy) noexcept { m_busy = busy; }
+  bool busy(void) const noexcept { return m_busy || m_refused; }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Returns RNR while busy, REJ while frames are missing or RR,
+   *             with the next N(S) expected.
+   */
+  Frame status(void) const
+  {
+    const auto type = busy() ? Frame::Type::RNR : m_rejecting ? Frame::Type::REJ : Frame::Type::RR;
+    return Frame(type, true, secondary(), m_recieve_seq);
+  }
+
 private:
+  StatusError handle_information(const Frame& cmd, Frame& resp)
+  {
+    if (busy())
+    {
+      if (cmd.is_poll())
+        resp = poll_response();
+      return StatusError::Success;
+    }
+
+    if (cmd.get_send_sequence() != m_recieve_seq)
+    {
+      if (m_selective)
+        hold(cmd);
+      else
+        m_rejecting = true;
+      if (cmd.is_poll())
+        resp = poll_response();
+      return StatusError::Success;
+    }
+
+    m_rejecting = false;
+    Frame reply(Frame::Type::UNSET);
+    auto  ret = deliver(cmd, reply);
+
+    // Frames held behind this one are now in sequence. Their answers were
+    // given when they arrived.
+    while (ret == StatusError::Success && !m_refused && m_held[m_recieve_seq].is_valid())
+    {
+      Frame held(Frame::Type::UNSET);
+      std::swap(held, m_held[m_recieve_seq]);
+      Frame unused(Frame::Type::UNSET);
+      ret = deliver(held, unused);
+      if (m_refused)
+        std::swap(held, m_held[m_recieve_seq]);
+    }
+
+    if (ret != StatusError::Success || !cmd.is_poll())
+      return ret; // Only a poll may be answered.
+
+    if (reply.is_information())
+    {
+      reply.set_poll(true);
+      reply.set_address(secondary());
+      reply.set_recieve_sequence(m_recieve_seq);
+      reply.set_send_sequence(m_send_seq);
+      m_send_seq = next(m_send_seq);
+      resp       = std::move(reply);
+    }
+    else
+    {
+      resp = reply.is_valid() ? std::move(reply) : poll_response();
+    }
+    return StatusError::Success;
+  }
+
+  StatusError deliver(const Frame& cmd, Frame& reply)
+  {
+    const auto ret = m_handler_map.count(Frame::Type::I) ? m_handler_map[Frame::Type::I](*this, cmd, reply) : default_handler(*this, cmd, reply);
+    switch (ret)
+    {
+    case StatusError::Success: m_recieve_seq = next(m_recieve_seq); return ret;
+    case StatusError::Busy:
+      // Not taken, the master sends it again.
+      m_refused = true;
+      reply     = Frame(Frame::Type::UNSET);
+      return StatusError::Success;
+    default: return ret;
+    }
+  }
+
+  /**
+   * @brief      Checks the N(R) of a command against the responses sent.
+   *
+   * @return     false if it acknowledges a response which was never sent.
+   */
+  bool acknowledge(const Frame& cmd)
+  {
+    const auto nr = cmd.get_recieve_sequence();
+    if (distance(m_ack_seq, nr) > distance(m_ack_seq, m_send_seq))
+      return false;
+
+    m_ack_seq = nr;
+    // Responses are not repeated. Those the master missed by the time it
+    // polls again are dropped and their numbers used again.
+    if (cmd.is_poll())
+      m_send_seq = nr;
+    return true;
+  }
+
+  /**
+   * @brief      Keeps a frame which arrived after a gap, frames further
+   *             away than half the sequence space are repeats and dropped.
+   */
+  void hold(const Frame& cmd)
+  {
+    const auto seq = cmd.get_send_sequence();
+    if (distance(m_recieve_seq, seq) < modulus() / 2)
+      m_held[seq] = cmd;
+  }
+
+  void release_held(void)
+  {
+    for (auto& frame : m_held) frame = Frame(Frame::Type::UNSET);
+  }
+
+  /**
+   * @brief      Answers a poll with status(). When frames are held each
+   *             gap before the last of them is requested with SREJ first.
+   */
+  Frame poll_response(void)
+  {
+    if (busy())
+    {
+      // Reported, a refused frame is tried again when it is repeated.
+      const auto resp = status();
+      m_refused       = false;
+      return resp;
+    }
+
+    size_t last = 0;
+    for (size_t i = 1; i < modulus() / 2; ++i)
+    {
+      if (m_held[(m_recieve_seq + i) % modulus()].is_valid())
+        last = i;
+    }
+
+    for (size_t i = 0; i < last; ++i)
+    {
+      const auto seq = static_cast<uint8_t>((m_recieve_seq + i) % modulus());
+      if (!m_held[seq].is_valid())
+        m_io.send_frame(Frame(Frame::Type::SREJ, false, secondary(), seq));
+    }
+    return status();
+  }
+
   io_t&                                  m_io;
   std::map<const Frame::Type, handler_t> m_handler_map;
+  bool                                   m_rejecting = false; //! An information frame is missing.
+  bool                                   m_selective = false; //! Hold frames after a gap and request the gap with SREJ.
+  bool                                   m_refused   = false; //! The handler refused a frame since the last poll.
+  std::atomic<bool>                      m_busy{false};       //! Local busy, see set_busy().
+  std::vector<Frame>                     m_held;              //! Frames received after a gap, by N(S).
 };
 
 } // namespace snrm
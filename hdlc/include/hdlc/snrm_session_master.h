@@ -9,11 +9,13 @@
 
 #include "frame.h"
 #include "io.h"
-#include "session.h"
 #include "types.h"
+#include "windowed_session.h"
 
 #include "stream_helper.h"
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <vector>
@@ -33,84 +35,184 @@ namespace snrm
  *
  * @tparam     io_t  IO type
  *
+ * @details    Information frames are numbered and kept until the secondary
+ *             acknowledges them, up to window() frames may be in flight.
+ *             The poll bit is set once half the window is outstanding so
+ *             the acknowledgement is on its way back while the rest of the
+ *             window is sent. A frame the secondary rejects or never
+ *             acknowledges is sent again along with every frame after it
+ *             (go back N), a frame named in an SREJ is sent again on its
+ *             own. A missing response is retried max_retries times by
+ *             polling with RR before the link is dropped.
+ *
+ *             While the secondary answers RNR no new information frames are
+ *             sent, it is polled every busy_poll_interval until it answers
+ *             RR. An N(R) acknowledging a frame never sent is answered with
+ *             StatusError::InvalidSequence and the link is dropped.
+ *
+ *             With set_extended() the link is set up with SNRME, the
+ *             control field is two bytes and up to 127 frames may be in
+ *             flight.
  */
 template <typename io_t>
-class Master : public Session
+class Master : public WindowedSession
 {
 
 public:
-  Master(io_t& io, const uint paddr = 0xFF, const uint8_t saddr = 0xFF) : Session(paddr, saddr), m_io(io) {}
+  using information_handler = std::function<void(const Frame&)>; //! Called with information frames the secondary sends.
+
+  static constexpr size_t max_retries        = 3;    //! Polls without a response before the link is dropped.
+  static constexpr size_t send_timeout       = 2000; //! Milliseconds to wait for room in the out pipe.
+  static constexpr size_t busy_poll_interval = 10;   //! Milliseconds between polls while the secondary is busy.
+
+  Master(io_t& io, const uint paddr = 0xFF, const uint8_t saddr = 0xFF) : WindowedSession(paddr, saddr), m_io(io) {}
   virtual ~Master() {}
 
   StatusError send_recieve(const Frame& cmd, Frame& resp)
   {
-
-    if (!m_io.send_frame(cmd))
-    {
-      return StatusError::FailedToSend;
-    }
-
-    if (cmd.is_poll())
-    {
-
-      for (;;)
-      {
-        Frame temp(Frame::Type::UNSET);
-        if (m_io.recieve_frame(temp) == false)
-          return StatusError::NoResponse;
-        else if (resp.get_address() != primary())
-          return StatusError::InvalidAddress;
-        else
-        {
-          resp = std::move(temp);
-          break;
-        }
-      }
-    }
-
-    return StatusError::Success;
+    return recieve_response(m_io.send_frame(cmd), cmd.is_poll(), resp);
   }
 
   StatusError send_command(const Frame& cmd, Frame& resp)
   {
-    auto ret = send_recieve(cmd, resp);
+    return check_response(send_recieve(cmd, resp), cmd.is_poll(), resp);
+  }
 
-    if (cmd.is_poll() && ret == StatusError::Success)
-    {
-      switch (resp.get_type())
-      {
-      case Frame::Type::SARM_DM: ret = StatusError::ConnectionError; break;
-      default: break;
-      }
-    }
+  /**
+   * @author     lokraszewski
+   * @date       28-Feb-2019
+   * @brief      Sends a payload and waits until it is acknowledged.
+   *
+   * @details    Stop and wait, anything queued before is acknowledged first.
+   *             The response overload returns the payload of an information
+   *             frame the secondary answers with, empty if it only
+   *             acknowledged.
+   */
+  template <typename buffer_t>
+  StatusError send_payload(const buffer_t& buffer)
+  {
+    Frame resp;
+    return send_information(Frame(buffer, Frame::Type::I, true, m_secondary), resp);
+  }
 
-    if (ret != StatusError::Success)
+  template <typename tx_buffer_t, typename rx_buffer_t>
+  StatusError send_payload(const tx_buffer_t& command, rx_buffer_t& response)
+  {
+    Frame      resp;
+    const auto ret = send_information(Frame(command, Frame::Type::I, true, m_secondary), resp);
+    if (ret == StatusError::Success)
     {
-      disconnect();
-      return StatusError::ConnectionError;
+      response.assign(resp.begin(), resp.end());
     }
-
     return ret;
   }
 
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Queues a payload without waiting for it to be acknowledged.
+   *
+   * @return     Status, ConnectionError if the link is not connected.
+   *
+   * @details    Only blocks while the window is full. Call flush() to wait
+   *             for everything queued to be acknowledged. Information frames
+   *             the secondary answers with go to the information handler.
+   */
   template <typename buffer_t>
-  StatusError send_payload(const buffer_t& buffer)
+  StatusError queue_payload(const buffer_t& buffer)
   {
-    const Frame cmd(buffer, Frame::Type::I, true, m_secondary);
-    Frame       resp;
-    const auto  ret = send_command(cmd, resp);
-    return ret;
+    if (!connected())
+      return StatusError::ConnectionError;
+
+    return checked(queue(Frame(buffer, Frame::Type::I, false, m_secondary), false));
   }
 
-  template <typename tx_buffer_t, typename rx_buffer_t>
-  StatusError send_payload(const tx_buffer_t& command, rx_buffer_t& response)
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Waits until every queued frame has been acknowledged.
+   */
+  StatusError flush(void) { return checked(wait_for_window(1)); }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Sets the number of frames which may be in flight.
+   *
+   * @param[in]  window  Clamped to [1, extended_modulus - 1], 1 is stop and
+   *                     wait.
+   *
+   * @details    window() is further limited to modulus() - 1 of the link.
+   *             Keep it at most modulus() / 2 with a client using selective
+   *             reject.
+   */
+  using WindowedSession::set_window;
+  using WindowedSession::window;
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Sets up the link with SNRME instead of SNRM on the next
+   *             connect(), for sequence numbers modulo 128.
+   */
+  void set_extended(const bool extended) noexcept { m_extended = extended; }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Limits the bytes of information frames in flight.
+   *
+   * @param[in]  bytes  0, the default, for no limit.
+   *
+   * @details    Set it to the capacity of the secondary's in pipe, less room
+   *             for a few supervisory frames, and the secondary can never be
+   *             sent more than it can hold however slowly it reads. Frames
+   *             are counted as if every payload byte which needs escaping
+   *             was escaped and the header and FCS twice over. A frame is
+   *             always sent when nothing else is outstanding.
+   */
+  using WindowedSession::set_window_bytes;
+  using WindowedSession::window_bytes;
+
+  using WindowedSession::outstanding;
+  using WindowedSession::outstanding_bytes;
+
+  /**
+   * @brief      true while the secondary answers RNR.
+   */
+  bool remote_busy(void) const noexcept { return m_remote_busy; }
+
+  void set_information_handler(information_handler handler) { m_information_handler = std::move(handler); }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Sends an information frame with the payload gathered from
+   *             borrowed spans.
+   *
+   * @param[in]  payload  Payload parts, sent back to back like an iovec.
+   *
+   * @return     Status
+   *
+   * @details    The parts are escaped straight into the out pipe so large
+   *             buffers are copied once instead of into a Frame first. Stop
+   *             and wait, the parts are sent again from the caller's buffers
+   *             if the frame has to be repeated.
+   */
+  StatusError send_payload_parts(span<const span<const uint8_t>> payload)
+  {
+    Frame resp;
+    return send_parts(payload, resp);
+  }
+
+  template <typename rx_buffer_t>
+  StatusError send_payload_parts(span<const span<const uint8_t>> payload, rx_buffer_t& response)
   {
-    const Frame cmd(command, Frame::Type::I, true, m_secondary);
-    Frame       resp;
-    const auto  ret = send_command(cmd, resp);
+    Frame      resp;
+    const auto ret = send_parts(payload, resp);
     if (ret == StatusError::Success)
     {
-      response = resp.get_payload();
+      response.assign(resp.begin(), resp.end());
     }
     return ret;
   }
@@ -135,7 +237,7 @@ public:
   {
     if (!connected())
     {
-      const Frame cmd(Frame::Type::SNRM, true, m_secondary);
+      const Frame cmd(m_extended ? Frame::Type::SNRME : Frame::Type::SNRM, true, m_secondary);
       Frame       resp;
       auto        ret = send_command(cmd, resp);
 
@@ -143,7 +245,11 @@ public:
       {
         if (resp.get_type() == Frame::Type::UA)
         {
+          const auto field = m_extended ? ControlField::Extended : ControlField::Basic;
+          set_control_field(field);
+          m_io.set_control_field(field);
           set_status(ConnectionStatus::Connected);
+          reset_window();
           ret = StatusError::Success;
         }
         else
@@ -161,7 +267,324 @@ public:
   }
 
 private:
-  io_t& m_io;
+  StatusError send_information(Frame cmd, Frame& resp)
+  {
+    m_response   = &resp;
+    auto     ret = queue(std::move(cmd), true);
+    if (ret == StatusError::Success)
+      ret = wait_for_window(1);
+    m_response = nullptr;
+    return checked(ret);
+  }
+
+  StatusError send_parts(span<const span<const uint8_t>> payload, Frame& resp)
+  {
+    sent_frame entry;
+    entry.frame = Frame(Frame::Type::I, true, m_secondary);
+    entry.parts = payload;
+
+    m_response = &resp;
+    auto ret   = queue(std::move(entry), 1, true);
+    if (ret == StatusError::Success)
+      ret = wait_for_window(1);
+    m_response = nullptr;
+    return checked(ret);
+  }
+
+  StatusError queue(Frame&& frame, const bool poll)
+  {
+    sent_frame entry;
+    entry.frame = std::move(frame);
+    return queue(std::move(entry), window(), poll);
+  }
+
+  /**
+   * @brief      Waits for room in the window, numbers a frame, keeps it for
+   *             repeating and sends it.
+   */
+  StatusError queue(sent_frame&& entry, const size_t limit, const bool poll)
+  {
+    entry.bytes    = frame_bytes<typename io_t::serializer_type>(entry);
+    const auto ret = wait_for_room(limit, entry.bytes);
+    if (ret != StatusError::Success)
+      return ret;
+
+    const auto seq = push(std::move(entry));
+    // Poll once half the window is out so the acknowledgement overlaps
+    // with sending the other half.
+    return transmit(seq, poll || (!m_polling && outstanding() >= (window() + 1) / 2));
+  }
+
+  /**
+   * @brief      Handles responses until a frame of the given size may be
+   *             sent, the secondary is not busy and fewer than limit frames
+   *             are outstanding.
+   */
+  StatusError wait_for_room(const size_t limit, const size_t bytes)
+  {
+    while (m_remote_busy || !has_room(limit, bytes))
+    {
+      const auto ret = await_response();
+      if (ret != StatusError::Success)
+        return ret;
+    }
+    return StatusError::Success;
+  }
+
+  /**
+   * @brief      Handles responses until fewer than limit frames are
+   *             outstanding.
+   */
+  StatusError wait_for_window(const size_t limit)
+  {
+    while (outstanding() >= limit)
+    {
+      const auto ret = await_response();
+      if (ret != StatusError::Success)
+        return ret;
+    }
+    return StatusError::Success;
+  }
+
+  StatusError await_response(void)
+  {
+    if (!m_polling)
+    {
+      // Nothing will answer unless polled, a busy secondary is given time
+      // before asking again.
+      if (m_remote_busy)
+        m_io.sleep(busy_poll_interval);
+      const auto ret = send_status(true);
+      if (ret != StatusError::Success)
+        return ret;
+    }
+
+    Frame resp(Frame::Type::UNSET);
+    if (m_io.recieve_frame(resp) == false)
+    {
+      // Checkpoint, the response tells which frames to repeat.
+      m_polling = false;
+      return (++m_retries > max_retries) ? StatusError::NoResponse : StatusError::Success;
+    }
+
+    if (resp.get_address() != primary())
+      return StatusError::Success;
+
+    switch (resp.get_type())
+    {
+    case Frame::Type::I:
+    case Frame::Type::RR:
+    case Frame::Type::RNR:
+    case Frame::Type::REJ: break;
+    case Frame::Type::SREJ: return repeat(resp.get_recieve_sequence());
+    case Frame::Type::SARM_DM: return StatusError::ConnectionError;
+    default: return StatusError::Success; // Late response to something else.
+    }
+
+    if (!acknowledge(resp.get_recieve_sequence()))
+      return StatusError::InvalidSequence;
+    m_remote_busy = resp.get_type() == Frame::Type::RNR;
+
+    if (resp.is_information())
+      accept_information(resp);
+
+    if (resp.is_final() && m_polling)
+    {
+      m_polling = false;
+      m_retries = 0;
+      // Frames sent before the poll which are still not acknowledged were
+      // lost or rejected, repeat them and everything after. Unless the
+      // secondary asked for single frames, then it holds the others, or
+      // is busy, then they are repeated once it is ready.
+      const auto repeated = m_repeated;
+      m_repeated          = false;
+      if (!repeated && !m_remote_busy && lost_at_poll())
+        return retransmit();
+    }
+
+    return StatusError::Success;
+  }
+
+  /**
+   * @brief      Sends the frame named by an SREJ again, only that frame.
+   */
+  StatusError repeat(const uint8_t seq)
+  {
+    if (distance(m_ack_seq, seq) >= outstanding())
+      return StatusError::InvalidSequence;
+
+    m_repeated = true;
+    return transmit(seq, false);
+  }
+
+  /**
+   * @brief      Releases the frames acknowledged by N(R).
+   *
+   * @return     false if N(R) acknowledges a frame which was never sent.
+   */
+  bool acknowledge(const uint8_t nr)
+  {
+    if (!acknowledges_sent(nr))
+      return false;
+
+    if (release(nr))
+      m_retries = 0;
+    return true;
+  }
+
+  void accept_information(const Frame& frame)
+  {
+    if (frame.get_send_sequence() != m_recieve_seq)
+      return; // Repeated or out of order, responses are not repeated.
+
+    m_recieve_seq = next(m_recieve_seq);
+    if (m_response && m_response->is_empty())
+      *m_response = frame;
+    else if (m_information_handler)
+      m_information_handler(frame);
+  }
+
+  StatusError retransmit(void)
+  {
+    auto ret = StatusError::Success;
+    go_back([&](const uint8_t seq) {
+      ret = transmit(seq, next(seq) == m_send_seq);
+      return ret == StatusError::Success;
+    });
+    return ret;
+  }
+
+  StatusError transmit(const uint8_t seq, const bool poll)
+  {
+    auto& entry = m_sent[seq];
+    entry.frame.set_send_sequence(seq);
+    entry.frame.set_recieve_sequence(m_recieve_seq);
+    entry.frame.set_poll(poll);
+
+    const auto sent = send([&] {
+      if (entry.parts.size())
+        return m_io.send_frame(FrameView(Frame::Type::I, poll, m_secondary, m_recieve_seq, seq), entry.parts);
+      return m_io.send_frame(entry.frame);
+    });
+    if (!sent)
+      return StatusError::FailedToSend;
+
+    if (poll)
+    {
+      m_polling  = true;
+      m_poll_seq = next(seq);
+    }
+    return StatusError::Success;
+  }
+
+  StatusError send_status(const bool poll)
+  {
+    const Frame status(Frame::Type::RR, poll, m_secondary, m_recieve_seq);
+    if (!send([&] { return m_io.send_frame(status); }))
+      return StatusError::FailedToSend;
+
+    if (poll)
+    {
+      m_polling  = true;
+      m_poll_seq = m_send_seq;
+    }
+    return StatusError::Success;
+  }
+
+  /**
+   * @brief      Retries a send while the out pipe is full.
+   */
+  template <typename send_t>
+  bool send(send_t&& send_frame)
+  {
+    const auto start = m_io.get_tick();
+    while (!send_frame())
+    {
+      if (m_io.is_expired(start, send_timeout))
+        return false;
+      m_io.sleep(1);
+    }
+    return true;
+  }
+
+  /**
+   * @brief      Drops the link on any error, the window is lost with it.
+   */
+  StatusError checked(const StatusError ret)
+  {
+    if (ret != StatusError::Success)
+    {
+      disconnect();
+      reset_window();
+    }
+    return ret;
+  }
+
+  void reset_window(void)
+  {
+    reset_sent();
+    m_polling     = false;
+    m_repeated    = false;
+    m_remote_busy = false;
+    m_retries     = 0;
+  }
+
+  StatusError recieve_response(const bool sent, const bool poll, Frame& resp)
+  {
+    if (!sent)
+    {
+      return StatusError::FailedToSend;
+    }
+
+    if (poll)
+    {
+
+      for (;;)
+      {
+        Frame temp(Frame::Type::UNSET);
+        if (m_io.recieve_frame(temp) == false)
+          return StatusError::NoResponse;
+        else if (temp.get_address() != primary())
+          return StatusError::InvalidAddress;
+        else
+        {
+          resp = std::move(temp);
+          break;
+        }
+      }
+    }
+
+    return StatusError::Success;
+  }
+
+  StatusError check_response(StatusError ret, const bool poll, const Frame& resp)
+  {
+    if (poll && ret == StatusError::Success)
+    {
+      switch (resp.get_type())
+      {
+      case Frame::Type::SARM_DM: ret = StatusError::ConnectionError; break;
+      default: break;
+      }
+    }
+
+    if (ret != StatusError::Success)
+    {
+      disconnect();
+      return StatusError::ConnectionError;
+    }
+
+    return ret;
+  }
+
+  io_t&               m_io;
+  bool                m_extended    = false;   //! Set up the link with SNRME.
+  bool                m_remote_busy = false;   //! The secondary answered RNR.
+  bool                m_polling     = false;   //! Poll sent, final not yet received.
+  bool                m_repeated    = false;   //! Frames were repeated for SREJ since the poll.
+  size_t              m_retries     = 0;       //! Polls which went unanswered in a row.
+  Frame*              m_response    = nullptr; //! Receives the answer to send_payload().
+  information_handler m_information_handler;   //! Receives other information frames.
 };
 } // namespace snrm
 } // namespace session
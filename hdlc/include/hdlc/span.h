@@ -0,0 +1,82 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <type_traits>
+#include <utility>
+
+namespace hdlc
+{
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Non-owning view over a contiguous range.
+ *
+ * @tparam     T     Element type, use const T for read only views.
+ *
+ * @details    Minimal stand-in for std::span since the library targets
+ *             C++14.
+ */
+template <typename T>
+class span
+{
+public:
+  using element_type = T;
+  using value_type   = typename std::remove_cv<T>::type;
+  using iterator     = T*;
+  using size_type    = size_t;
+
+  constexpr span() noexcept = default;
+  constexpr span(T* data, const size_t size) noexcept : m_data(data), m_size(size) {}
+  constexpr span(T* begin, T* end) noexcept : m_data(begin), m_size(static_cast<size_t>(end - begin)) {}
+
+  template <size_t N>
+  constexpr span(T (&array)[N]) noexcept : m_data(array), m_size(N)
+  {
+  }
+
+  /**
+   * @brief      Views any container with data() and size(), such as vector
+   *             or string.
+   */
+  template <typename container_t,
+            typename = typename std::enable_if<std::is_convertible<decltype(std::declval<container_t&>().data()), T*>::value>::type>
+  constexpr span(container_t& container) noexcept : m_data(container.data()), m_size(container.size())
+  {
+  }
+
+  /**
+   * @brief      Allows span<T> to convert to span<const T>.
+   */
+  template <typename U, typename = typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value>::type>
+  constexpr span(const span<U>& other) noexcept : m_data(other.data()), m_size(other.size())
+  {
+  }
+
+  constexpr T*     data() const noexcept { return m_data; }
+  constexpr size_t size() const noexcept { return m_size; }
+  constexpr bool   empty() const noexcept { return m_size == 0; }
+  constexpr T*     begin() const noexcept { return m_data; }
+  constexpr T*     end() const noexcept { return m_data + m_size; }
+  constexpr T&     operator[](const size_t i) const noexcept { return m_data[i]; }
+  constexpr T&     front() const noexcept { return m_data[0]; }
+  constexpr T&     back() const noexcept { return m_data[m_size - 1]; }
+
+  constexpr span first(const size_t count) const noexcept { return span(m_data, count); }
+  constexpr span last(const size_t count) const noexcept { return span(m_data + m_size - count, count); }
+  constexpr span subspan(const size_t offset) const noexcept { return span(m_data + offset, m_size - offset); }
+  constexpr span subspan(const size_t offset, const size_t count) const noexcept { return span(m_data + offset, count); }
+
+private:
+  T*     m_data = nullptr;
+  size_t m_size = 0;
+};
+
+} // namespace hdlc
@@ -18,6 +18,7 @@ std::ostream& operator<<(std::ostream& os, const Frame::Type& type);
 std::ostream& operator<<(std::ostream& os, const Frame& f);
 std::ostream& operator<<(std::ostream& os, const StatusError& err);
 std::ostream& operator<<(std::ostream& os, const ConnectionStatus& status);
+std::ostream& operator<<(std::ostream& os, const ControlField& field);
 } // namespace hdlc
 
 #endif
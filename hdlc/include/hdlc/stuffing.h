@@ -0,0 +1,160 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+
+#include "types.h"
+#include <stddef.h>
+#include <stdint.h>
+
+namespace hdlc
+{
+namespace stuffing
+{
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Implementation used by the search functions.
+ */
+enum class kernel
+{
+  scalar, //! Portable byte at a time search.
+  sse2,   //! x86-64 16 bytes at a time.
+  avx2,   //! x86-64 32 bytes at a time.
+};
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Returns the kernel selected for this CPU.
+ *
+ * @details    The kernel is chosen once, on first use.
+ */
+kernel active_kernel(void) noexcept;
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Checks if a byte has to be escaped on the wire.
+ */
+constexpr bool is_special(const uint8_t byte) noexcept
+{
+  return (byte == protocol_bytes::frame_boundary) || (byte == protocol_bytes::escape);
+}
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Clean bytes walked one at a time before a run is handed to the
+ *             search kernel, for loops escaping like escape() does.
+ */
+constexpr ptrdiff_t probe_size = 16;
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Finds the first byte which has to be escaped.
+ *
+ * @return     Pointer to the byte or end if there is none.
+ */
+const uint8_t* find_special(const uint8_t* begin, const uint8_t* end) noexcept;
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Counts the bytes which have to be escaped.
+ */
+size_t count_special(const uint8_t* begin, const uint8_t* end) noexcept;
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Finds the first escape byte.
+ *
+ * @return     Pointer to the byte or end if there is none.
+ */
+const uint8_t* find_escape(const uint8_t* begin, const uint8_t* end) noexcept;
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Finds the first frame boundary.
+ *
+ * @return     Pointer to the byte or end if there is none.
+ */
+const uint8_t* find_flag(const uint8_t* begin, const uint8_t* end) noexcept;
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Escapes a block of bytes.
+ *
+ * @param[in]  begin  The first byte
+ * @param[in]  end    Past the last byte
+ * @param      out    Output, must have room for (end - begin) +
+ *                    count_special(begin, end) bytes.
+ *
+ * @return     Pointer past the last byte written.
+ *
+ * @details    Runs without special bytes are copied in bulk.
+ */
+uint8_t* escape(const uint8_t* begin, const uint8_t* end, uint8_t* out) noexcept;
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Removes escapes from a block of bytes.
+ *
+ * @param[in]  begin    The first byte
+ * @param[in]  end      Past the last byte
+ * @param      out      Output, must have room for (end - begin) bytes. May
+ *                      be begin itself to unescape in place.
+ * @param      pending  Escape state, set when the block ends in an escape so
+ *                      the next block can be continued. Start with false.
+ *
+ * @return     Pointer past the last byte written.
+ */
+uint8_t* unescape(const uint8_t* begin, const uint8_t* end, uint8_t* out, bool& pending) noexcept;
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Portable kernels, always available.
+ */
+const uint8_t* find_special_scalar(const uint8_t* begin, const uint8_t* end) noexcept;
+size_t         count_special_scalar(const uint8_t* begin, const uint8_t* end) noexcept;
+const uint8_t* find_escape_scalar(const uint8_t* begin, const uint8_t* end) noexcept;
+const uint8_t* find_flag_scalar(const uint8_t* begin, const uint8_t* end) noexcept;
+
+#if HDLC_USE_X86_SIMD
+namespace detail
+{
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Vector kernels.
+ *
+ * @details    Compare a whole register against the protocol bytes and turn
+ *             the result into a bit mask, so clean data is skipped 16 or 32
+ *             bytes at a time. SSE2 is part of x86-64, the AVX2 kernels must
+ *             only be called when avx2_supported() returns true.
+ */
+bool           avx2_supported(void) noexcept;
+const uint8_t* find_special_sse2(const uint8_t* begin, const uint8_t* end) noexcept;
+size_t         count_special_sse2(const uint8_t* begin, const uint8_t* end) noexcept;
+const uint8_t* find_escape_sse2(const uint8_t* begin, const uint8_t* end) noexcept;
+const uint8_t* find_flag_sse2(const uint8_t* begin, const uint8_t* end) noexcept;
+const uint8_t* find_special_avx2(const uint8_t* begin, const uint8_t* end) noexcept;
+size_t         count_special_avx2(const uint8_t* begin, const uint8_t* end) noexcept;
+const uint8_t* find_escape_avx2(const uint8_t* begin, const uint8_t* end) noexcept;
+const uint8_t* find_flag_avx2(const uint8_t* begin, const uint8_t* end) noexcept;
+} // namespace detail
+#endif
+
+} // namespace stuffing
+} // namespace hdlc
@@ -0,0 +1,120 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+
+#include "fd_io.h"
+#include "types.h"
+
+#if HDLC_USE_EPOLL
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unistd.h>
+
+namespace hdlc
+{
+namespace tty
+{
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Serial port settings.
+ */
+struct settings
+{
+  uint32_t baud           = 115200; //! Line rate, one of the standard termios rates.
+  bool     hardware_flow  = false;  //! RTS/CTS flow control.
+  bool     low_latency    = true;   //! Ask the driver not to batch received bytes, best effort.
+  bool     non_blocking   = true;   //! For a reactor, otherwise reads wait as set by vmin and vtime.
+  uint8_t  vmin           = 255;    //! Blocking reads return once this many bytes have arrived...
+  uint8_t  vtime          = 1;      //! ...or the line has been idle for this many tenths of a second.
+};
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Opens a serial device and configures it.
+ *
+ * @param[in]  path  Device path, for example /dev/ttyUSB0.
+ * @param[in]  s     Settings
+ *
+ * @return     The descriptor or -1.
+ *
+ * @details    The device is opened non blocking so a missing carrier does
+ *             not hang the open, and left that way only with
+ *             settings::non_blocking.
+ */
+int open(const char* path, const settings& s);
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Switches an open terminal to raw mode with the given settings.
+ *
+ * @details    8 data bits, no parity, one stop bit, no echo, no line editing
+ *             and no byte translation, so every byte arrives as sent.
+ *
+ * @return     false if the device refused the settings or the rate is not
+ *             a standard one.
+ */
+bool configure(const int fd, const settings& s);
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Sets or clears the low latency flag of a serial driver.
+ *
+ * @return     false if the device is not a serial port or the driver does
+ *             not support it, for example a pty.
+ */
+bool set_low_latency(const int fd, const bool enable);
+
+} // namespace tty
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      IO over a serial device.
+ *
+ * @tparam     fcs_t   Frame check sequence policy used on this link.
+ * @tparam     pipe_t  Pipe type, see basic_io.
+ *
+ * @details    Opens and owns the device. Bytes move in large chunks
+ *             straight between the device and the pipe storage, see
+ *             basic_fd_io. With settings::non_blocking the link is meant for
+ *             a reactor, otherwise handle_in() blocks as set by VMIN and
+ *             VTIME, so a dedicated receive thread sleeps until a chunk has
+ *             arrived or the line goes idle.
+ */
+template <typename fcs_t = fcs16, typename pipe_t = FramePipe>
+class basic_tty_io : public basic_fd_io<fcs_t, pipe_t>
+{
+public:
+  basic_tty_io(const char* path, const tty::settings& s = tty::settings(), const size_t buffer_size = 4096)
+      : basic_fd_io<fcs_t, pipe_t>(tty::open(path, s), buffer_size, s.non_blocking)
+  {
+  }
+
+  ~basic_tty_io()
+  {
+    if (is_open())
+      ::close(this->native_handle());
+  }
+
+  /**
+   * @brief      false if the device could not be opened or configured.
+   */
+  bool is_open(void) const noexcept { return this->native_handle() >= 0; }
+};
+
+using tty_io = basic_tty_io<>; //! Serial device IO using the default 16 bit FCS.
+
+} // namespace hdlc
+
+#endif
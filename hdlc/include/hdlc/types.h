@@ -12,6 +12,67 @@
 #define HDLC_USE_STD_MAP 0
 #endif
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HDLC_USE_CLMUL 1
+#define HDLC_USE_X86_SIMD 1
+#else
+#define HDLC_USE_CLMUL 0
+#define HDLC_USE_X86_SIMD 0
+#endif
+
+// Frame payloads and codec buffers come from per thread free lists, see
+// pool.h. Needs thread_local.
+#ifndef HDLC_USE_FRAME_POOL
+#ifdef __unix__
+#define HDLC_USE_FRAME_POOL 1
+#else
+#define HDLC_USE_FRAME_POOL 0
+#endif
+#endif
+
+// Blocks each per thread free list keeps per size class.
+#ifndef HDLC_POOL_MAX_FREE
+#define HDLC_POOL_MAX_FREE 64
+#endif
+
+// Links backed by file descriptors multiplexed by an epoll reactor, see
+// reactor.h.
+#ifndef HDLC_USE_EPOLL
+#ifdef __linux__
+#define HDLC_USE_EPOLL 1
+#else
+#define HDLC_USE_EPOLL 0
+#endif
+#endif
+
+// Links driven by an io_uring reactor, see uring_io.h. Needs the kernel
+// headers, the kernel itself is checked at run time.
+#ifndef HDLC_USE_IO_URING
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define HDLC_USE_IO_URING 1
+#endif
+#endif
+#endif
+#ifndef HDLC_USE_IO_URING
+#define HDLC_USE_IO_URING 0
+#endif
+
+// Pipes whose storage is mapped twice so wrapped data is contiguous, see
+// ring_storage.h. Needs memfd_create().
+#ifndef HDLC_USE_MIRRORED_RING
+#ifdef __linux__
+#define HDLC_USE_MIRRORED_RING 1
+#else
+#define HDLC_USE_MIRRORED_RING 0
+#endif
+#endif
+
+// Payloads up to this many bytes are stored inside the frame object.
+#ifndef HDLC_FRAME_INLINE_PAYLOAD
+#define HDLC_FRAME_INLINE_PAYLOAD 64
+#endif
+
 namespace hdlc
 {
 
@@ -53,4 +114,10 @@ enum class ConnectionStatus
   Connected,
 };
 
+enum class ControlField
+{
+  Basic,    //! One byte, sequence numbers modulo 8.
+  Extended, //! Two bytes in I and S frames, sequence numbers modulo 128.
+};
+
 } // namespace hdlc
@@ -0,0 +1,311 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+
+#include "io.h"
+#include "span.h"
+#include "types.h"
+
+#if HDLC_USE_IO_URING
+
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+namespace hdlc
+{
+
+class uring_reactor;
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Something a uring_reactor can drive.
+ *
+ * @details    The reactor keeps a read posted into the free space of the in
+ *             pipe and writes straight from the out pipe, both regions are
+ *             registered with the kernel once when the link is added. See
+ *             basic_uring_io.
+ */
+class uring_link
+{
+public:
+  uring_link() {}
+  uring_link(const uring_link&) = delete;
+  uring_link& operator=(const uring_link&) = delete;
+  virtual ~uring_link() {}
+
+  /**
+   * @brief      Descriptor the link reads from and writes to.
+   */
+  virtual int native_handle(void) const = 0;
+
+  /**
+   * @brief      Whole storage of the in and out pipes, registered as fixed
+   *             buffers.
+   */
+  virtual span<uint8_t> in_storage(void)  = 0;
+  virtual span<uint8_t> out_storage(void) = 0;
+
+  /**
+   * @brief      Contiguous free space at the tail of the in pipe.
+   */
+  virtual span<uint8_t> in_space(void) = 0;
+
+  /**
+   * @brief      Publishes bytes the kernel read into in_space().
+   */
+  virtual void in_commit(const size_t count) = 0;
+
+  /**
+   * @brief      Contiguous bytes at the head of the out pipe.
+   */
+  virtual span<uint8_t> out_data(void) = 0;
+
+  /**
+   * @brief      Removes bytes the kernel wrote from out_data().
+   */
+  virtual void out_consume(const size_t count) = 0;
+
+  /**
+   * @brief      false once the descriptor has closed or failed.
+   */
+  bool is_open(void) const noexcept { return !m_closed; }
+
+protected:
+  /**
+   * @brief      Asks the reactor to write the out pipe, cheap to call after
+   *             every frame.
+   */
+  void queue_out(void) noexcept;
+
+private:
+  friend class uring_reactor;
+
+  uring_reactor*    m_reactor = nullptr;    //! Set while registered.
+  std::atomic<bool> m_out_signalled{false}; //! Output queued since the reactor last looked.
+  size_t            m_slot    = 0;          //! Index in the reactor, the fixed buffers are 2 * slot and 2 * slot + 1.
+  bool              m_reading = false;      //! A read is posted.
+  bool              m_writing = false;      //! A write is posted.
+  bool              m_stalled = false;      //! The in pipe was full, no read is posted.
+  bool              m_closed  = false;      //! The descriptor has closed or failed.
+};
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Drives any number of links from one thread with io_uring.
+ *
+ * @details    Every link always has a read posted, the kernel copies
+ *             incoming bytes straight into the in pipe. Queued output is
+ *             written straight from the out pipe, the writes of every link
+ *             with output are submitted together with the reads in a single
+ *             io_uring_enter() call which also reaps completions, so under
+ *             load one system call serves many frames. Pipe storage is
+ *             registered as fixed buffers when the kernel supports it.
+ *
+ *             Each link must be the only producer of its in pipe and the only
+ *             consumer of its out pipe besides the reactor, for example do
+ *             not call in_byte() or reset() on a registered link. Links must
+ *             outlive their registration, remove them from the thread running
+ *             the reactor or once it has stopped.
+ */
+class uring_reactor
+{
+public:
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Reactor counters.
+   */
+  struct statistics
+  {
+    size_t enters    = 0; //! io_uring_enter() calls.
+    size_t submitted = 0; //! Requests submitted.
+    size_t completed = 0; //! Completions reaped.
+  };
+
+  /**
+   * @param[in]  max_links  Most links registered at once.
+   */
+  explicit uring_reactor(const size_t max_links = 64);
+  ~uring_reactor();
+  uring_reactor(const uring_reactor&) = delete;
+  uring_reactor& operator=(const uring_reactor&) = delete;
+
+  /**
+   * @brief      false if the kernel does not support io_uring.
+   */
+  bool is_open(void) const noexcept { return m_ring >= 0; }
+
+  /**
+   * @brief      true if pipe storage is registered as fixed buffers.
+   */
+  bool fixed_buffers(void) const noexcept { return m_fixed; }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Starts driving a link.
+   *
+   * @return     true if registered.
+   */
+  bool add(uring_link& link);
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Stops driving a link.
+   *
+   * @return     true if it was registered.
+   *
+   * @details    Cancels the requests of the link and waits for them.
+   */
+  bool remove(uring_link& link);
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Submits queued requests, waits for completions and handles
+   *             them.
+   *
+   * @param[in]  timeout_ms  Maximum wait, -1 waits until a completion
+   *                         arrives.
+   *
+   * @return     Number of completions handled.
+   */
+  size_t run_once(const int timeout_ms);
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Handles completions until stop() is called.
+   */
+  void run(void);
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Makes run() return, may be called from any thread.
+   */
+  void stop(void);
+
+  size_t size(void) const noexcept { return m_count; }
+
+  /**
+   * @brief      Counters, read them on the reactor thread or once it has
+   *             stopped.
+   */
+  statistics get_statistics(void) const noexcept { return m_stats; }
+
+private:
+  friend class uring_link;
+
+  struct sqe_ring;
+  struct cqe_ring;
+
+  void  wake(void) noexcept;
+  void* get_sqe(void);
+  void  post_read(uring_link& link);
+  void  post_write(uring_link& link);
+  void  post_wake(void);
+  void  post_cancel(const uint64_t user_data);
+  void  flush_signalled(void);
+  void  complete(const uint64_t user_data, const int32_t result);
+  void  close(uring_link& link);
+  bool  update_buffers(const size_t slot, span<uint8_t> in, span<uint8_t> out);
+
+  int                      m_ring    = -1;        //! io_uring descriptor.
+  int                      m_event   = -1;        //! eventfd written by links with output and by stop().
+  bool                     m_fixed   = false;     //! Pipe storage is registered.
+  std::vector<uring_link*> m_links;               //! Registered links by slot, null if free.
+  size_t                   m_count   = 0;         //! Registered links.
+  size_t                   m_stalled = 0;         //! Links waiting for space in their in pipe.
+  sqe_ring*                m_sq      = nullptr;   //! Submission queue.
+  cqe_ring*                m_cq      = nullptr;   //! Completion queue.
+  unsigned                 m_pending = 0;         //! Requests queued but not submitted.
+  uint64_t                 m_wake_value = 0;      //! eventfd read target.
+  std::atomic<bool>        m_wake_pending{false}; //! m_event written since the last read.
+  std::atomic<bool>        m_stopping{false};     //! Set by stop().
+  statistics               m_stats;
+};
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      IO over a file descriptor, driven by a uring_reactor.
+ *
+ * @tparam     fcs_t   Frame check sequence policy used on this link.
+ * @tparam     pipe_t  Pipe type, see basic_io.
+ *
+ * @details    Same use as basic_fd_io. The descriptor is not closed, it
+ *             must outlive the object. handle_in() and handle_out() do
+ *             nothing, the reactor moves all bytes. Complete frames are
+ *             passed to the on_frame() subscriber straight from the reactor.
+ */
+template <typename fcs_t = fcs16, typename pipe_t = FramePipe>
+class basic_uring_io : public basic_io<fcs_t, pipe_t>, public uring_link
+{
+public:
+  basic_uring_io(const int fd, const size_t buffer_size = 512) : basic_io<fcs_t, pipe_t>(buffer_size), m_fd(fd)
+  {
+    // io_uring hands EAGAIN back for non blocking descriptors instead of
+    // waiting for them.
+    const auto flags = ::fcntl(m_fd, F_GETFL);
+    if (flags >= 0 && (flags & O_NONBLOCK))
+      ::fcntl(m_fd, F_SETFL, flags & ~O_NONBLOCK);
+  }
+
+  int native_handle(void) const override { return m_fd; }
+
+  size_t get_tick(void) const override
+  {
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    return static_cast<size_t>(now);
+  }
+
+  bool handle_out(void) override { return is_open(); }
+  bool handle_in(void) override { return is_open(); }
+
+  void reset(void) override
+  {
+    this->m_out_pipe.clear();
+    this->m_in_pipe.clear();
+  }
+
+  void sleep(const size_t ms) override { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+  span<uint8_t> in_storage(void) override { return this->m_in_pipe.storage(); }
+  span<uint8_t> out_storage(void) override { return this->m_out_pipe.storage(); }
+  span<uint8_t> in_space(void) override { return this->m_in_pipe.writable_regions().first; }
+  span<uint8_t> out_data(void) override { return this->m_out_pipe.readable_regions().first; }
+
+  void in_commit(const size_t count) override
+  {
+    this->m_in_pipe.commit(count);
+    this->dispatch_frames();
+  }
+
+  void out_consume(const size_t count) override { this->m_out_pipe.consume(count); }
+
+protected:
+  void out_queued(void) override { queue_out(); }
+
+private:
+  int m_fd; //! Link descriptor, not owned.
+};
+
+using uring_io = basic_uring_io<>; //! io_uring driven IO using the default 16 bit FCS.
+
+} // namespace hdlc
+
+#endif
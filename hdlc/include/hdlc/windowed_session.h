@@ -0,0 +1,213 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+
+#include "frame.h"
+#include "session.h"
+#include "span.h"
+#include "types.h"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace hdlc
+{
+namespace session
+{
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Session which numbers the information frames it sends and
+ *             keeps them until they are acknowledged.
+ *
+ * @details    Holds the send window shared by the NRM master and the ABM
+ *             peer: the frames in flight by N(S), how many frames and bytes
+ *             may be in flight, and V(S) at the last poll. Sending, waiting
+ *             and locking are left to the session.
+ */
+class WindowedSession : public Session
+{
+public:
+  WindowedSession(const uint8_t primary, const uint8_t secondary) : Session(primary, secondary), m_sent(extended_modulus) {}
+  virtual ~WindowedSession() {}
+
+protected:
+  /**
+   * @brief      An information frame kept until it is acknowledged.
+   */
+  struct sent_frame
+  {
+    Frame                           frame;
+    span<const span<const uint8_t>> parts;     //! Borrowed payload, used instead of the frame payload when not empty.
+    size_t                          bytes = 0; //! Most bytes it takes in the out pipe.
+  };
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Sets the number of frames which may be in flight.
+   *
+   * @param[in]  window  Clamped to [1, extended_modulus - 1], 1 is stop and
+   *                     wait.
+   *
+   * @details    window() is further limited to modulus() - 1 of the link.
+   */
+  void   set_window(const size_t window) noexcept { m_window = std::max<size_t>(1, std::min<size_t>(window, extended_modulus - 1)); }
+  size_t window(void) const noexcept { return std::min<size_t>(m_window, modulus() - 1); }
+
+  /**
+   * @author     lokraszewski
+   * @date       16-Oct-2026
+   * @brief      Limits the bytes of information frames in flight.
+   *
+   * @param[in]  bytes  0, the default, for no limit.
+   *
+   * @details    Set it to the capacity of the other end's in pipe, less
+   *             room for a few supervisory frames, and the other end can
+   *             never be sent more than it can hold however slowly it reads.
+   *             Frames are counted as if every payload byte which needs
+   *             escaping was escaped and the header and FCS twice over. A
+   *             frame is always sent when nothing else is outstanding.
+   */
+  void   set_window_bytes(const size_t bytes) noexcept { m_window_bytes = bytes; }
+  size_t window_bytes(void) const noexcept { return m_window_bytes; }
+
+  /**
+   * @brief      Number of frames sent but not yet acknowledged.
+   */
+  size_t outstanding(void) const noexcept { return distance(m_ack_seq, m_send_seq); }
+
+  /**
+   * @brief      Bytes of the frames sent but not yet acknowledged, see
+   *             set_window_bytes().
+   */
+  size_t outstanding_bytes(void) const noexcept { return m_outstanding_bytes; }
+
+  /**
+   * @brief      true if a frame of the given size may be sent with fewer
+   *             than limit frames outstanding.
+   */
+  bool has_room(const size_t limit, const size_t bytes) const noexcept
+  {
+    return outstanding() < limit && !(m_window_bytes && outstanding() && m_outstanding_bytes + bytes > m_window_bytes);
+  }
+
+  /**
+   * @brief      Most bytes a frame takes in the out pipe of an io using
+   *             serializer_t, whose FCS sets the overhead.
+   */
+  template <typename serializer_t>
+  static size_t frame_bytes(const sent_frame& entry)
+  {
+    size_t bytes = 2 * serializer_t::frame_min_size;
+    if (entry.parts.size())
+    {
+      for (const auto& part : entry.parts) bytes += escaped_bytes(part.begin(), part.end());
+    }
+    else
+    {
+      bytes += escaped_bytes(entry.frame.begin(), entry.frame.end());
+    }
+    return bytes;
+  }
+
+  /**
+   * @brief      Keeps a frame under V(S) and advances it.
+   *
+   * @return     N(S) of the frame.
+   */
+  uint8_t push(sent_frame&& entry)
+  {
+    const auto seq = m_send_seq;
+    m_outstanding_bytes += entry.bytes;
+    m_sent[seq] = std::move(entry);
+    m_send_seq  = next(seq);
+    return seq;
+  }
+
+  /**
+   * @brief      Releases the frames acknowledged by N(R).
+   *
+   * @return     Number of frames released, check acknowledges_sent() first.
+   */
+  size_t release(const uint8_t nr)
+  {
+    const auto count = distance(m_ack_seq, nr);
+    for (auto i = count; i--;)
+    {
+      m_outstanding_bytes -= m_sent[m_ack_seq].bytes;
+      m_sent[m_ack_seq] = sent_frame();
+      m_ack_seq         = next(m_ack_seq);
+    }
+    return count;
+  }
+
+  /**
+   * @brief      false if N(R) acknowledges a frame which was never sent.
+   */
+  bool acknowledges_sent(const uint8_t nr) const noexcept { return distance(m_ack_seq, nr) <= outstanding(); }
+
+  /**
+   * @brief      Number of frames sent before the last poll which are still
+   *             not acknowledged, those were lost once the final answer is
+   *             in.
+   */
+  size_t lost_at_poll(void) const noexcept
+  {
+    const auto lost = distance(m_ack_seq, m_poll_seq);
+    return lost <= outstanding() ? lost : 0;
+  }
+
+  /**
+   * @brief      Calls transmit(seq) for every frame not acknowledged, oldest
+   *             first, until it returns false (go back N).
+   *
+   * @return     false if a transmit failed.
+   */
+  template <typename transmit_t>
+  bool go_back(transmit_t&& transmit)
+  {
+    for (auto seq = m_ack_seq; seq != m_send_seq; seq = next(seq))
+    {
+      if (!transmit(seq))
+        return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief      Forgets every frame in flight, done whenever a link is set
+   *             up or dropped.
+   */
+  void reset_sent(void)
+  {
+    reset_sequence();
+    for (auto& entry : m_sent) entry = sent_frame();
+    m_outstanding_bytes = 0;
+    m_poll_seq          = 0;
+  }
+
+  std::vector<sent_frame> m_sent;                                     //! Frames not yet acknowledged, by N(S).
+  size_t                  m_window            = extended_modulus - 1; //! Most frames in flight, see window().
+  size_t                  m_window_bytes      = 0;                    //! Most bytes in flight, 0 for no limit.
+  size_t                  m_outstanding_bytes = 0;                    //! Bytes of the frames not yet acknowledged.
+  uint8_t                 m_poll_seq          = 0;                    //! V(S) when the poll was sent.
+
+private:
+  template <typename iterator_t>
+  static size_t escaped_bytes(iterator_t first, iterator_t last)
+  {
+    const auto escapes = std::count_if(first, last, [](const uint8_t byte) { return byte == protocol_bytes::frame_boundary || byte == protocol_bytes::escape; });
+    return static_cast<size_t>(std::distance(first, last) + escapes);
+  }
+};
+
+} // namespace session
+} // namespace hdlc
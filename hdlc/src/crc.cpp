@@ -0,0 +1,125 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include "hdlc/crc.h"
+
+namespace hdlc
+{
+namespace crc
+{
+
+constexpr ccitt16::value_type ccitt16::poly;
+constexpr ccitt16::value_type ccitt16::initial;
+constexpr ccitt16::value_type ccitt16::final_xor;
+constexpr crc32::value_type   crc32::poly;
+constexpr crc32::value_type   crc32::initial;
+constexpr crc32::value_type   crc32::final_xor;
+
+namespace
+{
+constexpr auto ccitt16_table = make_table16<8>(ccitt16::poly);
+constexpr auto crc32_table   = make_table32_reflected<8>(crc32::poly);
+
+/**
+ * @brief      Function pointers picked once for this CPU.
+ */
+struct dispatch_table
+{
+  kernel type;
+  ccitt16::value_type (*ccitt16_update)(ccitt16::value_type, const uint8_t*, const uint8_t*) noexcept;
+  crc32::value_type (*crc32_update)(crc32::value_type, const uint8_t*, const uint8_t*) noexcept;
+};
+
+dispatch_table select_kernels(void) noexcept
+{
+#if HDLC_USE_CLMUL
+  if (detail::clmul_supported())
+  {
+    return {kernel::clmul, detail::ccitt16_clmul, detail::crc32_clmul};
+  }
+#endif
+  return {kernel::table, ccitt16::update_table, crc32::update_table};
+}
+
+const dispatch_table& kernels(void) noexcept
+{
+  static const dispatch_table k = select_kernels();
+  return k;
+}
+} // namespace
+
+kernel active_kernel(void) noexcept { return kernels().type; }
+
+ccitt16::value_type ccitt16::update(value_type crc, const uint8_t* begin, const uint8_t* end) noexcept
+{
+  return kernels().ccitt16_update(crc, begin, end);
+}
+
+ccitt16::value_type ccitt16::update_table(value_type crc, const uint8_t* begin, const uint8_t* end) noexcept
+{
+  const auto& t = ccitt16_table.data;
+
+  while ((end - begin) >= 8)
+  {
+    const uint16_t x = crc ^ static_cast<uint16_t>((begin[0] << 8) | begin[1]);
+
+    crc = t[7][x >> 8] ^ t[6][x & 0xFF] ^ t[5][begin[2]] ^ t[4][begin[3]] ^ t[3][begin[4]] ^ t[2][begin[5]] ^ t[1][begin[6]] ^
+          t[0][begin[7]];
+    begin += 8;
+  }
+
+  return update_bytewise(crc, begin, end);
+}
+
+ccitt16::value_type ccitt16::update_bytewise(value_type crc, const uint8_t* begin, const uint8_t* end) noexcept
+{
+  const auto& t = ccitt16_table.data[0];
+
+  while (begin != end)
+  {
+    crc = static_cast<uint16_t>((crc << 8) ^ t[(crc >> 8) ^ *begin++]);
+  }
+
+  return crc;
+}
+
+crc32::value_type crc32::update(value_type crc, const uint8_t* begin, const uint8_t* end) noexcept
+{
+  return kernels().crc32_update(crc, begin, end);
+}
+
+crc32::value_type crc32::update_table(value_type crc, const uint8_t* begin, const uint8_t* end) noexcept
+{
+  const auto& t = crc32_table.data;
+
+  while ((end - begin) >= 8)
+  {
+    const uint32_t x = crc ^ (static_cast<uint32_t>(begin[0]) | static_cast<uint32_t>(begin[1]) << 8 |
+                              static_cast<uint32_t>(begin[2]) << 16 | static_cast<uint32_t>(begin[3]) << 24);
+
+    crc = t[7][x & 0xFF] ^ t[6][(x >> 8) & 0xFF] ^ t[5][(x >> 16) & 0xFF] ^ t[4][x >> 24] ^ t[3][begin[4]] ^ t[2][begin[5]] ^
+          t[1][begin[6]] ^ t[0][begin[7]];
+    begin += 8;
+  }
+
+  return update_bytewise(crc, begin, end);
+}
+
+crc32::value_type crc32::update_bytewise(value_type crc, const uint8_t* begin, const uint8_t* end) noexcept
+{
+  const auto& t = crc32_table.data[0];
+
+  while (begin != end)
+  {
+    crc = (crc >> 8) ^ t[(crc ^ *begin++) & 0xFF];
+  }
+
+  return crc;
+}
+
+} // namespace crc
+} // namespace hdlc
@@ -0,0 +1,199 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include "hdlc/crc.h"
+
+#if HDLC_USE_CLMUL
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define HDLC_CLMUL_TARGET __attribute__((target("pclmul,ssse3")))
+
+namespace hdlc
+{
+namespace crc
+{
+namespace detail
+{
+
+namespace
+{
+
+/**
+ * @brief      Computes x^n mod P in normal (non-reflected) bit order.
+ *
+ * @param[in]  n      The exponent
+ * @param[in]  poly   The polynomial without the leading term
+ * @param[in]  width  The degree of the polynomial
+ */
+constexpr uint64_t xpow_mod(const unsigned n, const uint64_t poly, const unsigned width)
+{
+  uint64_t r = 1;
+  for (unsigned i = 0; i < n; ++i)
+  {
+    r <<= 1;
+    if ((r >> width) & 1)
+      r ^= (uint64_t(1) << width) | poly;
+  }
+  return r;
+}
+
+constexpr uint64_t reflect64(uint64_t v)
+{
+  uint64_t r = 0;
+  for (auto i = 0; i < 64; ++i)
+  {
+    r = (r << 1) | (v & 1);
+    v >>= 1;
+  }
+  return r;
+}
+
+/*
+ * The buffer is treated as a sequence of 128 bit polynomials B0..Bn. An
+ * accumulator A is folded forward with A * x^128 + B by splitting A into its
+ * high (H) and low (L) halves and multiplying each by a precomputed
+ * x^k mod P, so only two 64x64 carry-less multiplies are needed per block.
+ * Four accumulators run in parallel 512 bits apart to hide the multiply
+ * latency. The final 128 bit remainder is congruent to the folded prefix
+ * modulo P, so running it through the tables gives the same CRC register.
+ */
+
+/**
+ * @brief      MSB first 16 bit domain. Blocks are byte swapped on load so the
+ *             first byte holds the highest degree coefficients.
+ */
+struct ccitt16_domain
+{
+  using value_type = ccitt16::value_type;
+
+  static constexpr uint64_t poly = 0x1021;
+  static constexpr uint64_t k(const unsigned n) { return xpow_mod(n, poly, 16); }
+
+  HDLC_CLMUL_TARGET static __m128i swap_mask(void) { return _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15); }
+  HDLC_CLMUL_TARGET static __m128i k128(void) { return _mm_set_epi64x(k(192), k(128)); }
+  HDLC_CLMUL_TARGET static __m128i k512(void) { return _mm_set_epi64x(k(576), k(512)); }
+
+  HDLC_CLMUL_TARGET static __m128i load(const uint8_t* p)
+  {
+    return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), swap_mask());
+  }
+
+  HDLC_CLMUL_TARGET static __m128i inject(const __m128i x, const value_type crc)
+  {
+    return _mm_xor_si128(x, _mm_set_epi64x(static_cast<long long>(uint64_t(crc) << 48), 0));
+  }
+
+  HDLC_CLMUL_TARGET static void store(const __m128i x, uint8_t* p)
+  {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_shuffle_epi8(x, swap_mask()));
+  }
+
+  static value_type table(value_type crc, const uint8_t* begin, const uint8_t* end) noexcept
+  {
+    return ccitt16::update_table(crc, begin, end);
+  }
+};
+
+/**
+ * @brief      LSB first 32 bit domain. Bit i of a loaded block holds the
+ *             coefficient of x^(127 - i), multiplying two reflected values
+ *             yields the reflected product shifted down by one, which is
+ *             absorbed by using x^(k - 1) for the constants.
+ */
+struct crc32_domain
+{
+  using value_type = crc32::value_type;
+
+  static constexpr uint64_t poly = 0x04C11DB7;
+  static constexpr uint64_t k(const unsigned n) { return reflect64(xpow_mod(n - 1, poly, 32)); }
+
+  HDLC_CLMUL_TARGET static __m128i k128(void) { return _mm_set_epi64x(k(128), k(192)); }
+  HDLC_CLMUL_TARGET static __m128i k512(void) { return _mm_set_epi64x(k(512), k(576)); }
+
+  HDLC_CLMUL_TARGET static __m128i load(const uint8_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+
+  HDLC_CLMUL_TARGET static __m128i inject(const __m128i x, const value_type crc)
+  {
+    return _mm_xor_si128(x, _mm_cvtsi32_si128(static_cast<int>(crc)));
+  }
+
+  HDLC_CLMUL_TARGET static void store(const __m128i x, uint8_t* p) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x); }
+
+  static value_type table(value_type crc, const uint8_t* begin, const uint8_t* end) noexcept
+  {
+    return crc32::update_table(crc, begin, end);
+  }
+};
+
+HDLC_CLMUL_TARGET inline __m128i fold(const __m128i acc, const __m128i k, const __m128i data)
+{
+  return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(acc, k, 0x00), _mm_clmulepi64_si128(acc, k, 0x11)), data);
+}
+
+template <typename domain_t>
+HDLC_CLMUL_TARGET typename domain_t::value_type fold_update(typename domain_t::value_type crc, const uint8_t* begin,
+                                                            const uint8_t* end) noexcept
+{
+  if ((end - begin) < 64)
+    return domain_t::table(crc, begin, end);
+
+  auto x0 = domain_t::inject(domain_t::load(begin), crc);
+  auto x1 = domain_t::load(begin + 16);
+  auto x2 = domain_t::load(begin + 32);
+  auto x3 = domain_t::load(begin + 48);
+  begin += 64;
+
+  const auto k512 = domain_t::k512();
+  while ((end - begin) >= 64)
+  {
+    x0 = fold(x0, k512, domain_t::load(begin));
+    x1 = fold(x1, k512, domain_t::load(begin + 16));
+    x2 = fold(x2, k512, domain_t::load(begin + 32));
+    x3 = fold(x3, k512, domain_t::load(begin + 48));
+    begin += 64;
+  }
+
+  const auto k128 = domain_t::k128();
+  auto       x    = fold(fold(fold(x0, k128, x1), k128, x2), k128, x3);
+  while ((end - begin) >= 16)
+  {
+    x = fold(x, k128, domain_t::load(begin));
+    begin += 16;
+  }
+
+  uint8_t remainder[16];
+  domain_t::store(x, remainder);
+  return domain_t::table(domain_t::table(0, remainder, remainder + sizeof(remainder)), begin, end);
+}
+
+} // namespace
+
+bool clmul_supported(void) noexcept
+{
+  unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    return false;
+  return (ecx & bit_PCLMUL) && (ecx & bit_SSSE3);
+}
+
+ccitt16::value_type ccitt16_clmul(ccitt16::value_type crc, const uint8_t* begin, const uint8_t* end) noexcept
+{
+  return fold_update<ccitt16_domain>(crc, begin, end);
+}
+
+crc32::value_type crc32_clmul(crc32::value_type crc, const uint8_t* begin, const uint8_t* end) noexcept
+{
+  return fold_update<crc32_domain>(crc, begin, end);
+}
+
+} // namespace detail
+} // namespace crc
+} // namespace hdlc
+
+#endif
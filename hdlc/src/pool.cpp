@@ -0,0 +1,116 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include "hdlc/pool.h"
+
+#include <new>
+
+namespace hdlc
+{
+namespace pool
+{
+
+namespace
+{
+struct free_block
+{
+  free_block* next;
+};
+
+/**
+ * @brief      Per thread free lists, one per size class.
+ *
+ * @details    Trivially destructible so it stays usable while other thread
+ *             local objects are destroyed, the guard below drains it.
+ */
+struct free_lists
+{
+  free_block* head[class_count];
+  size_t      length[class_count];
+  statistics  stats;
+  bool        closed;
+};
+
+thread_local free_lists l_lists = {};
+
+void drain(free_lists& lists) noexcept
+{
+  for (size_t i = 0; i < class_count; ++i)
+  {
+    while (auto block = lists.head[i])
+    {
+      lists.head[i] = block->next;
+      ::operator delete(block);
+    }
+    lists.length[i] = 0;
+  }
+}
+
+/**
+ * @brief      Returns the cached blocks to the heap when the thread exits.
+ *             Blocks freed after that go straight to the heap.
+ */
+struct free_lists_guard
+{
+  ~free_lists_guard()
+  {
+    l_lists.closed = true;
+    drain(l_lists);
+  }
+};
+
+thread_local free_lists_guard l_guard;
+} // namespace
+
+void* allocate(const size_t size)
+{
+  const auto index = size_class(size);
+  auto&      lists = l_lists;
+
+  if (index < class_count && lists.head[index])
+  {
+    const auto block  = lists.head[index];
+    lists.head[index] = block->next;
+    --lists.length[index];
+    ++lists.stats.hits;
+    return block;
+  }
+
+  // Touching the guard registers its destructor for this thread.
+  (void)&l_guard;
+  ++lists.stats.misses;
+  return ::operator new((index < class_count) ? (smallest_class << index) : size);
+}
+
+void deallocate(void* block, const size_t size) noexcept
+{
+  if (block == nullptr)
+    return;
+
+  const auto index = size_class(size);
+  auto&      lists = l_lists;
+
+  if (index < class_count && !lists.closed && lists.length[index] < HDLC_POOL_MAX_FREE)
+  {
+    (void)&l_guard;
+    const auto node   = static_cast<free_block*>(block);
+    node->next        = lists.head[index];
+    lists.head[index] = node;
+    ++lists.length[index];
+    return;
+  }
+
+  ++lists.stats.releases;
+  ::operator delete(block);
+}
+
+statistics thread_statistics(void) noexcept { return l_lists.stats; }
+
+void reset_thread_statistics(void) noexcept { l_lists.stats = statistics(); }
+
+} // namespace pool
+} // namespace hdlc
@@ -0,0 +1,250 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include "hdlc/reactor.h"
+
+#if HDLC_USE_EPOLL
+
+#include <algorithm>
+#include <errno.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace hdlc
+{
+
+namespace
+{
+constexpr int max_events = 64; //! Events fetched per epoll_wait().
+
+void drain_eventfd(const int fd) noexcept
+{
+  uint64_t count;
+  while (::read(fd, &count, sizeof(count)) < 0 && errno == EINTR)
+  {
+  }
+}
+} // namespace
+
+reactor::reactor() : m_epoll(::epoll_create1(EPOLL_CLOEXEC)), m_stop(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+  if (m_epoll < 0 || m_stop < 0)
+    return;
+
+  epoll_event event = {};
+  event.events      = EPOLLIN;
+  event.data.ptr    = nullptr; // Only the stop descriptor has no handle.
+  if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_stop, &event) < 0)
+  {
+    ::close(m_epoll);
+    m_epoll = -1;
+  }
+}
+
+reactor::~reactor()
+{
+  if (m_epoll >= 0)
+    ::close(m_epoll);
+  if (m_stop >= 0)
+    ::close(m_stop);
+}
+
+constexpr int reactor::stall_retry_ms;
+
+bool reactor::add(reactor_link& link)
+{
+  if (!is_open() || link.m_reactor)
+    return false;
+
+  epoll_event event = {};
+  event.events      = EPOLLIN;
+  event.data.ptr    = &link.m_in_handle;
+  if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, link.native_handle(), &event) < 0)
+    return false;
+
+  if (link.event_handle() >= 0)
+  {
+    event.data.ptr = &link.m_out_handle;
+    if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, link.event_handle(), &event) < 0)
+    {
+      ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, link.native_handle(), nullptr);
+      return false;
+    }
+  }
+
+  link.m_reactor  = this;
+  link.m_want_in  = true;
+  link.m_want_out = false;
+  link.m_armed    = true;
+  ++m_links;
+
+  // Anything queued before the link was added.
+  flush(link);
+  return true;
+}
+
+bool reactor::remove(reactor_link& link)
+{
+  if (link.m_reactor != this)
+    return false;
+
+  if (link.m_armed)
+    ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, link.native_handle(), nullptr);
+  if (link.event_handle() >= 0)
+    ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, link.event_handle(), nullptr);
+
+  m_stalled.erase(std::remove(m_stalled.begin(), m_stalled.end(), &link), m_stalled.end());
+  link.m_reactor = nullptr;
+  link.m_armed   = false;
+  --m_links;
+  return true;
+}
+
+size_t reactor::run_once(const int timeout_ms)
+{
+  resume_stalled();
+
+  // A full in pipe is only noticed when the reactor wakes, so do not sleep
+  // for long while a link is stalled.
+  const auto  wait = (m_stalled.empty() || (timeout_ms >= 0 && timeout_ms < stall_retry_ms)) ? timeout_ms : stall_retry_ms;
+  epoll_event events[max_events];
+  const auto  count = ::epoll_wait(m_epoll, events, max_events, wait);
+  if (count <= 0)
+    return 0;
+
+  for (int i = 0; i < count; ++i)
+  {
+    const auto handle = static_cast<reactor_handle*>(events[i].data.ptr);
+    if (handle == nullptr)
+    {
+      drain_eventfd(m_stop);
+      continue;
+    }
+
+    // An earlier event in this batch may have removed the link.
+    auto& link = *handle->link;
+    if (link.m_reactor != this)
+      continue;
+
+    if (handle->out)
+    {
+      drain_eventfd(link.event_handle());
+      flush(link);
+      continue;
+    }
+
+    if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+    {
+      if (link.on_readable() == false)
+      {
+        remove(link);
+        continue;
+      }
+      if (link.in_full())
+        stall(link);
+    }
+
+    if (events[i].events & EPOLLOUT)
+      flush(link);
+  }
+
+  return static_cast<size_t>(count);
+}
+
+void reactor::run(void)
+{
+  while (m_stopping.load(std::memory_order_acquire) == false)
+  {
+    run_once(-1);
+  }
+}
+
+void reactor::stop(void)
+{
+  m_stopping.store(true, std::memory_order_release);
+  const uint64_t one = 1;
+  while (::write(m_stop, &one, sizeof(one)) < 0 && errno == EINTR)
+  {
+  }
+}
+
+void reactor::flush(reactor_link& link)
+{
+  const auto done = link.on_writable();
+  if (done == link.m_want_out)
+    watch_out(link, !done);
+}
+
+bool reactor::watch_out(reactor_link& link, const bool want_out)
+{
+  const auto previous = link.m_want_out;
+  link.m_want_out     = want_out;
+  if (arm(link))
+    return true;
+
+  link.m_want_out = previous;
+  return false;
+}
+
+void reactor::stall(reactor_link& link)
+{
+  if (!link.m_want_in)
+    return;
+
+  link.m_want_in = false;
+  if (arm(link))
+    m_stalled.push_back(&link);
+  else
+    link.m_want_in = true;
+}
+
+void reactor::resume_stalled(void)
+{
+  for (auto it = m_stalled.begin(); it != m_stalled.end();)
+  {
+    auto& link = **it;
+    if (link.in_full())
+    {
+      ++it;
+      continue;
+    }
+
+    link.m_want_in = true;
+    arm(link);
+    it = m_stalled.erase(it);
+  }
+}
+
+bool reactor::arm(reactor_link& link)
+{
+  // A descriptor left in the set with no events asked for still reports hang
+  // ups, which would wake a stalled link just as readability does, so it is
+  // taken out instead.
+  const uint32_t events = (link.m_want_in ? static_cast<uint32_t>(EPOLLIN) : 0u) | (link.m_want_out ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+  if (events == 0)
+  {
+    if (link.m_armed && ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, link.native_handle(), nullptr) < 0)
+      return false;
+    link.m_armed = false;
+    return true;
+  }
+
+  epoll_event event = {};
+  event.events      = events;
+  event.data.ptr    = &link.m_in_handle;
+  if (::epoll_ctl(m_epoll, link.m_armed ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, link.native_handle(), &event) < 0)
+    return false;
+
+  link.m_armed = true;
+  return true;
+}
+
+} // namespace hdlc
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include "hdlc/ring_storage.h"
+
+#if HDLC_USE_MIRRORED_RING
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace hdlc
+{
+
+namespace
+{
+/**
+ * @brief      Maps size bytes of a memfd twice, back to back.
+ *
+ * @return     The first copy or nullptr.
+ */
+uint8_t* map_twice(const size_t size) noexcept
+{
+  const int fd = ::memfd_create("hdlc-ring", MFD_CLOEXEC);
+  if (fd < 0)
+    return nullptr;
+
+  uint8_t* base = nullptr;
+  if (::ftruncate(fd, static_cast<off_t>(size)) == 0)
+  {
+    // Reserve the whole range first so nothing else can be mapped between
+    // the copies, then place both copies over it.
+    auto reserved = ::mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (reserved != MAP_FAILED)
+    {
+      base             = static_cast<uint8_t*>(reserved);
+      const auto flags = MAP_SHARED | MAP_FIXED | MAP_POPULATE;
+      if (::mmap(base, size, PROT_READ | PROT_WRITE, flags, fd, 0) == MAP_FAILED ||
+          ::mmap(base + size, size, PROT_READ | PROT_WRITE, flags, fd, 0) == MAP_FAILED)
+      {
+        ::munmap(base, 2 * size);
+        base = nullptr;
+      }
+    }
+  }
+
+  // The mappings keep the memory alive.
+  ::close(fd);
+  return base;
+}
+} // namespace
+
+mirrored_ring::mirrored_ring(const size_t size)
+{
+  const auto page = page_size();
+  m_size          = ((size ? size : 1) + page - 1) / page * page;
+  m_data          = map_twice(m_size);
+  m_mirrored      = (m_data != nullptr);
+
+  if (!m_mirrored)
+  {
+    m_fallback.resize(m_size);
+    m_data = m_fallback.data();
+  }
+}
+
+mirrored_ring::~mirrored_ring()
+{
+  if (m_mirrored)
+    ::munmap(m_data, 2 * m_size);
+}
+
+size_t mirrored_ring::page_size(void) noexcept
+{
+  const auto page = ::sysconf(_SC_PAGESIZE);
+  return page > 0 ? static_cast<size_t>(page) : 4096;
+}
+
+} // namespace hdlc
+
+#endif
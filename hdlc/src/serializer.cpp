@@ -6,16 +6,18 @@
  */
 
 #include "hdlc/serializer.h"
+#include "hdlc/stuffing.h"
 
 #include <algorithm>
 #include <assert.h>
+#include <string.h>
 
 namespace hdlc
 {
 
-boost::crc_basic<16> FrameSerializer::crc_ccitt = boost::crc_basic<16>(0x1021, 0xFFFF, 0, false, false);
-
-auto FrameSerializer::get_frame_type(const uint8_t control)
+namespace
+{
+Frame::Type frame_type_from_control(const uint8_t control)
 {
   if ((control & 1) == 0) // bit 0 clear indicates information frame.
   {
@@ -50,6 +52,9 @@ auto FrameSerializer::get_frame_type(const uint8_t control)
     case Frame::Type::SNRM:
     case Frame::Type::NR1:
     case Frame::Type::NR3:
+    case Frame::Type::SARME:
+    case Frame::Type::SNRME:
+    case Frame::Type::SABME:
     case Frame::Type::TEST:
     case Frame::Type::UNSET: return type;
     default: return Frame::Type::UNSET;
@@ -57,17 +62,48 @@ auto FrameSerializer::get_frame_type(const uint8_t control)
   }
 }
 
-std::vector<uint8_t> FrameSerializer::serialize(const Frame &frame)
+/**
+ * @brief      Size of the control field given its first byte. Only I and S
+ *             frames have the second byte in extended mode.
+ */
+size_t control_size(const uint8_t control, const ControlField field)
+{
+  return (field == ControlField::Extended && (control & 0b11) != 0b11) ? 2 : 1;
+}
+
+} // namespace
+
+template <typename fcs_t>
+auto BasicFrameSerializer<fcs_t>::get_frame_type(const uint8_t control)
+{
+  return frame_type_from_control(control);
+}
+
+template <typename fcs_t>
+size_t BasicFrameSerializer<fcs_t>::put_control(const FrameView &frame, const ControlField field, uint8_t *out)
 {
-  uint8_t control_byte = static_cast<uint8_t>(frame.get_type());
+  const uint8_t type = static_cast<uint8_t>(frame.get_type());
+  const uint8_t nr   = frame.get_recieve_sequence();
+  const uint8_t ns   = frame.get_send_sequence();
+  const uint8_t poll = frame.is_poll() ? 1 : 0;
 
   switch (frame.get_type())
   {
   case Frame::Type::RR:
   case Frame::Type::RNR:
   case Frame::Type::REJ:
-  case Frame::Type::SREJ: control_byte |= (frame.get_recieve_sequence()) << 5; break;
-  case Frame::Type::I: control_byte |= (frame.get_send_sequence()) << 1 | (frame.get_recieve_sequence()) << 5; break;
+  case Frame::Type::SREJ:
+  case Frame::Type::I:
+    if (field == ControlField::Extended)
+    {
+      // N(S) or the S frame type in the first byte, N(R) and P/F in the
+      // second.
+      out[0] = frame.is_information() ? static_cast<uint8_t>(ns << 1) : type;
+      out[1] = static_cast<uint8_t>(nr << 1 | poll);
+      return 2;
+    }
+    out[0] = static_cast<uint8_t>(type | (ns & 0b111) << 1 | (nr & 0b111) << 5);
+    break;
   case Frame::Type::UI:
   case Frame::Type::SABM:
   case Frame::Type::UA:
@@ -83,179 +119,521 @@ std::vector<uint8_t> FrameSerializer::serialize(const Frame &frame)
   case Frame::Type::NR2:
   case Frame::Type::NR1:
   case Frame::Type::NR3:
-  case Frame::Type::TEST: break;
+  case Frame::Type::SARME:
+  case Frame::Type::SNRME:
+  case Frame::Type::SABME:
+  case Frame::Type::TEST: out[0] = type; break;
   case Frame::Type::UNSET:
   default: assert(false); // Unknown frame type;
   }
 
-  std::vector<uint8_t> frame_serialized;
-
-  frame_serialized.reserve(frame.is_payload_type() ? (6 + frame.payload_size()) : 6);
-
-  if (frame.is_poll())
+  if (poll)
   {
-    control_byte |= (uint8_t)header_bits::poll_flag;
+    out[0] |= (uint8_t)header_bits::poll_flag;
   }
 
-  frame_serialized.emplace_back(protocol_bytes::frame_boundary);
-  frame_serialized.emplace_back(frame.get_address());
-  frame_serialized.emplace_back(control_byte);
+  return 1;
+}
+
+template <typename fcs_t>
+size_t BasicFrameSerializer<fcs_t>::serialized_size(const Frame &frame, const ControlField field)
+{
+  const auto size = frame_min_size + (field == ControlField::Extended && !frame.is_unnumbered() ? 1 : 0);
+  return frame.is_payload_type() ? (size + frame.payload_size()) : size;
+}
+
+template <typename fcs_t>
+void BasicFrameSerializer<fcs_t>::serialize_into(const Frame &frame, const ControlField field, uint8_t *out)
+{
+  const auto body = out + 1;
+
+  *out++ = protocol_bytes::frame_boundary;
+  *out++ = frame.get_address();
+  out += put_control(frame, field, out);
 
   if (frame.is_payload_type())
   {
-    frame_serialized.insert(frame_serialized.end(), frame.begin(), frame.end());
+    out = std::copy(frame.begin(), frame.end(), out);
   }
 
-  append_checksum(frame_serialized);
-  frame_serialized.emplace_back(protocol_bytes::frame_boundary);
+  out  = fcs_t::write(checksum(body, out), out);
+  *out = protocol_bytes::frame_boundary;
+}
 
-  return frame_serialized;
+template <typename fcs_t>
+size_t BasicFrameSerializer<fcs_t>::escaped_size(span<const uint8_t> frame)
+{
+  return frame.size() + stuffing::count_special(frame.begin() + 1, frame.end() - 1);
 }
-std::vector<uint8_t> FrameSerializer::escape(const std::vector<uint8_t> &frame)
+
+template <typename fcs_t>
+void BasicFrameSerializer<fcs_t>::escape_into(span<const uint8_t> frame, uint8_t *out)
 {
-  auto extra_size = std::count_if(frame.begin() + 1, frame.end() - 1, [](const auto byte) {
-    return (byte == protocol_bytes::frame_boundary) || (byte == protocol_bytes::escape);
-  });
+  *out = protocol_bytes::frame_boundary;
+  out  = stuffing::escape(frame.begin() + 1, frame.end() - 1, out + 1);
+  *out = protocol_bytes::frame_boundary;
+}
 
-  std::vector<uint8_t> escaped;
-  escaped.reserve(frame.size() + extra_size);
-  escaped.emplace_back(protocol_bytes::frame_boundary);
+namespace
+{
+/**
+ * @brief      Writes escaped bytes across up to two output spans.
+ */
+class escape_writer
+{
+public:
+  escape_writer(span<uint8_t> first, span<uint8_t> second)
+      : m_begin(first.begin()), m_pos(first.begin()), m_end(first.end()), m_next(second)
+  {
+  }
+
+  size_t written() const noexcept { return m_done + (m_pos - m_begin); }
+
+  bool put(const uint8_t byte)
+  {
+    if (m_pos == m_end && !next_segment())
+      return false;
+    *m_pos++ = byte;
+    return true;
+  }
 
-  for_each(frame.begin() + 1, frame.end() - 1, [&](const auto byte) {
+  bool put_escaped(const uint8_t byte)
+  {
     switch (byte)
     {
     case protocol_bytes::frame_boundary:
-    case protocol_bytes::escape:
-      escaped.emplace_back(protocol_bytes::escape);
-      escaped.emplace_back(byte ^ (uint8_t)header_bits::stuffing);
-      break;
-    default: escaped.emplace_back(byte); break;
+    case protocol_bytes::escape: return put(protocol_bytes::escape) && put(byte ^ (uint8_t)header_bits::stuffing);
+    default: return put(byte);
+    }
+  }
+
+  /**
+   * @brief      Escapes a block, long runs without special bytes are copied
+   *             in bulk.
+   */
+  bool write_escaped(const uint8_t *begin, const uint8_t *end)
+  {
+    while (begin != end)
+    {
+      const auto probe = begin + std::min(end - begin, stuffing::probe_size);
+      while (begin != probe && !stuffing::is_special(*begin))
+      {
+        if (!put(*begin++))
+          return false;
+      }
+
+      const auto run = (begin == probe) ? stuffing::find_special(begin, end) : begin;
+
+      while (begin != run)
+      {
+        if (m_pos == m_end && !next_segment())
+          return false;
+        const auto count = std::min<size_t>(run - begin, m_end - m_pos);
+        memcpy(m_pos, begin, count);
+        m_pos += count;
+        begin += count;
+      }
+
+      if (begin != end && !put_escaped(*begin++))
+        return false;
     }
-  });
+    return true;
+  }
+
+private:
+  bool next_segment()
+  {
+    if (m_next.empty())
+      return false;
+    m_done += m_pos - m_begin;
+    m_begin = m_pos = m_next.begin();
+    m_end           = m_next.end();
+    m_next          = span<uint8_t>();
+    return true;
+  }
+
+  uint8_t *     m_begin;
+  uint8_t *     m_pos;
+  uint8_t *     m_end;
+  span<uint8_t> m_next;
+  size_t        m_done = 0;
+};
+} // namespace
 
-  escaped.emplace_back(protocol_bytes::frame_boundary);
-  return escaped;
+template <typename fcs_t>
+size_t BasicFrameSerializer<fcs_t>::encode(const FrameView &frame, span<uint8_t> first, span<uint8_t> second, const ControlField field)
+{
+  const span<const uint8_t> payload[] = {frame.get_payload()};
+  return encode(frame, payload, first, second, field);
 }
 
-Frame FrameSerializer::deserialize(const std::vector<uint8_t> &buffer)
+template <typename fcs_t>
+size_t BasicFrameSerializer<fcs_t>::encode(const FrameView &header, span<const span<const uint8_t>> payload, span<uint8_t> first,
+                                           span<uint8_t> second, const ControlField field)
 {
+  using crc_t = typename fcs_t::crc_type;
+
+  // The CRC runs over a chunk which is then escaped while it is still in
+  // cache, so the payload is only streamed from memory once.
+  static constexpr size_t chunk_size = 2048;
+
+  escape_writer out(first, second);
+  uint8_t    fields[3] = {header.get_address()};
+  const auto end       = fields + 1 + put_control(header, field, fields + 1);
+  auto       crc       = crc_t::update(crc_t::initial, fields, end);
 
-  if (buffer.size() < FRAME_MIN_SIZE)
+  if (!out.put(protocol_bytes::frame_boundary) || !out.write_escaped(fields, end))
+    return 0;
+
+  if (header.is_payload_type())
   {
-    return Frame(Frame::Type::UNSET);
+    for (const auto part : payload)
+    {
+      const uint8_t *it  = part.begin();
+      const uint8_t *end = part.end();
+      while (it != end)
+      {
+        const auto chunk = it + std::min<size_t>(end - it, chunk_size);
+        crc              = crc_t::update(crc, it, chunk);
+        if (!out.write_escaped(it, chunk))
+          return 0;
+        it = chunk;
+      }
+    }
   }
 
-  auto it  = buffer.begin();
-  auto end = buffer.end();
+  uint8_t trailer[fcs_t::size];
+  fcs_t::write(crc_t::finalize(crc), trailer);
+  if (!out.write_escaped(trailer, trailer + sizeof(trailer)) || !out.put(protocol_bytes::frame_boundary))
+    return 0;
 
-  if (!is_checksum_valid(it, end))
+  return out.written();
+}
+
+template <typename fcs_t>
+FrameView BasicFrameSerializer<fcs_t>::parse(span<const uint8_t> raw, const ControlField field)
+{
+  if (raw.size() < frame_min_size)
   {
-    return Frame(Frame::Type::UNSET);
+    return FrameView();
   }
 
-  if (*it++ != protocol_bytes::frame_boundary)
+  if (!is_checksum_valid(raw.begin(), raw.end()))
   {
-    return Frame(Frame::Type::UNSET);
+    return FrameView();
   }
 
-  if (*(--end) != protocol_bytes::frame_boundary)
+  if (raw.front() != protocol_bytes::frame_boundary || raw.back() != protocol_bytes::frame_boundary)
   {
-    return Frame(Frame::Type::UNSET);
+    return FrameView();
   }
 
-  std::advance(end, -2); // Consume FCS and frame boundary.
+  // Payload sits between the control field and the FCS.
+  const auto extra = control_size(raw[2], field) - 1;
+  if (raw.size() < frame_min_size + extra)
+  {
+    return FrameView();
+  }
 
-  auto       address     = *it++;
-  auto       control     = *it++;
-  const auto poll        = (control & (uint8_t)header_bits::poll_flag) ? true : false;
-  const auto type        = get_frame_type(control);
-  const auto send_seq    = (control >> 1) & 0b111;
-  const auto recieve_seq = (control >> 5) & 0b111;
+  const auto payload = raw.subspan(3 + extra, raw.size() - frame_min_size - extra);
+  return make_view(raw[1], raw.subspan(2, 1 + extra), payload);
+}
 
+namespace
+{
+/**
+ * @brief      Whether a frame type keeps the bytes between the control field
+ *             and the FCS.
+ */
+bool keeps_payload(const Frame::Type type)
+{
   switch (type)
   {
-  case Frame::Type::I: return Frame(it, end, type, poll, address, recieve_seq, send_seq);
+  case Frame::Type::I:
   case Frame::Type::REJ:
   case Frame::Type::RR:
   case Frame::Type::RNR:
-  case Frame::Type::SREJ: return Frame(it, end, type, poll, address, recieve_seq);
+  case Frame::Type::SREJ:
   case Frame::Type::TEST:
-  case Frame::Type::UI: return Frame(it, end, type, poll, address);
-  case Frame::Type::SABM:
-  case Frame::Type::UA:
-  case Frame::Type::SARM_DM:
-  case Frame::Type::XID:
-  case Frame::Type::SNRM:
-  case Frame::Type::UP:
-  case Frame::Type::SIM_RIM:
-  case Frame::Type::DISC_RD:
-  case Frame::Type::RSET:
-  case Frame::Type::FRMR:
-  case Frame::Type::NR0:
-  case Frame::Type::NR2:
-  case Frame::Type::NR1:
-  case Frame::Type::NR3: return Frame(type, poll, address);
-  default: return Frame(Frame::Type::UNSET);
+  case Frame::Type::UI: return true;
+  default: return false;
+  }
+}
+} // namespace
+
+template <typename fcs_t>
+FrameView BasicFrameSerializer<fcs_t>::make_view(const uint8_t address, span<const uint8_t> control, span<const uint8_t> payload)
+{
+  const auto type = get_frame_type(control[0]);
+  if (type == Frame::Type::UNSET)
+    return FrameView();
+
+  if (control.size() == 2)
+  {
+    const auto poll = (control[1] & 1) ? true : false;
+    return FrameView(type, poll, address, control[1] >> 1, control[0] >> 1, keeps_payload(type) ? payload : span<const uint8_t>());
   }
+
+  const auto poll        = (control[0] & (uint8_t)header_bits::poll_flag) ? true : false;
+  const auto send_seq    = (control[0] >> 1) & 0b111;
+  const auto recieve_seq = (control[0] >> 5) & 0b111;
+
+  // Sequence numbers a type does not carry are masked by the accessors.
+  return FrameView(type, poll, address, recieve_seq, send_seq, keeps_payload(type) ? payload : span<const uint8_t>());
 }
 
-std::vector<uint8_t> FrameSerializer::descape(const std::vector<uint8_t> &buffer)
+template <typename fcs_t>
+Frame BasicFrameSerializer<fcs_t>::make_frame(const uint8_t address, span<const uint8_t> control, Frame::payload_type &&payload)
 {
-  const auto escaped = std::count_if(buffer.begin(), buffer.end(), [](const auto byte) { return byte == protocol_bytes::escape; });
-  std::vector<uint8_t> descaped;
-  descaped.reserve(buffer.size() - escaped);
+  const auto view = make_view(address, control, span<const uint8_t>());
+  Frame      frame(view);
+
+  if (keeps_payload(view.get_type()))
+    frame.set_payload(std::move(payload));
 
-  for_each(buffer.begin(), buffer.end(), [&](const auto byte) {
-    static bool escaped = false;
-    if (escaped)
+  return frame;
+}
+
+namespace
+{
+/**
+ * @brief      Collects unescaped frame bytes, splitting them into header,
+ *             payload and FCS on the fly.
+ *
+ * @details    The last FCS sized bytes seen are held back since they are
+ *             only known to be the FCS once the closing boundary is reached.
+ *             Everything else is checksummed as it is appended, while still
+ *             in cache.
+ */
+template <typename fcs_t>
+class unescape_sink
+{
+public:
+  using crc_t = typename fcs_t::crc_type;
+
+  unescape_sink(const size_t payload_bound, const ControlField field) : m_payload_bound(payload_bound), m_field(field) {}
+
+  void append(const uint8_t *begin, size_t count)
+  {
+    while (m_header_size < m_header_needed && count)
     {
-      descaped.emplace_back(byte ^ (uint8_t)header_bits::stuffing);
-      escaped = false;
+      m_header[m_header_size++] = *begin++;
+      --count;
+      if (m_header_size == 2)
+        m_header_needed = 1 + control_size(m_header[1], m_field);
+      if (m_header_size == m_header_needed)
+      {
+        m_crc  = crc_t::update(m_crc, m_header, m_header + m_header_size);
+        m_keep = keeps_payload(frame_type_from_control(m_header[1]));
+      }
     }
-    else if (byte == protocol_bytes::escape)
+
+    if (count == 0)
+      return;
+
+    constexpr auto hold = fcs_t::size;
+    if (count >= hold)
     {
-      escaped = true;
+      emit(m_hold, m_hold_size);
+      emit(begin, count - hold);
+      memcpy(m_hold, begin + count - hold, hold);
+      m_hold_size = hold;
     }
     else
     {
-      descaped.emplace_back(byte);
+      const auto overflow = (m_hold_size + count > hold) ? m_hold_size + count - hold : 0;
+      emit(m_hold, overflow);
+      memmove(m_hold, m_hold + overflow, m_hold_size - overflow);
+      memcpy(m_hold + m_hold_size - overflow, begin, count);
+      m_hold_size += count - overflow;
+    }
+  }
+
+  bool complete() const noexcept { return m_header_size == m_header_needed && m_hold_size == fcs_t::size; }
+  bool valid() const noexcept { return complete() && crc_t::finalize(m_crc) == fcs_t::read(m_hold); }
+
+  uint8_t                address() const noexcept { return m_header[0]; }
+  span<const uint8_t>    control() const noexcept { return span<const uint8_t>(m_header + 1, m_header_size - 1); }
+  Frame::payload_type && payload() noexcept { return std::move(m_payload); }
+
+private:
+  void emit(const uint8_t *begin, const size_t count)
+  {
+    if (count == 0)
+      return;
+
+    m_crc = crc_t::update(m_crc, begin, begin + count);
+    if (m_keep)
+    {
+      // Small payloads stay inline, larger ones move to the heap once with
+      // room for the largest payload this frame can hold.
+      if (m_payload.size() + count > m_payload.capacity())
+        m_payload.reserve(m_payload_bound);
+      m_payload.append(begin, begin + count);
+    }
+  }
+
+  const size_t                 m_payload_bound;
+  const ControlField           m_field;
+  typename crc_t::value_type   m_crc = crc_t::initial;
+  uint8_t                      m_header[3]; //! Address and a control field of one or two bytes.
+  size_t                       m_header_size   = 0;
+  size_t                       m_header_needed = 2; //! Known once the first control byte is in.
+  uint8_t                      m_hold[fcs_t::size];
+  size_t                       m_hold_size = 0;
+  bool                         m_keep      = false;
+  Frame::payload_type          m_payload;
+};
+} // namespace
+
+template <typename fcs_t>
+Frame BasicFrameSerializer<fcs_t>::decode(span<const uint8_t> first, span<const uint8_t> second, const ControlField field)
+{
+  const auto size = first.size() + second.size();
+  if (size < frame_min_size)
+  {
+    return Frame(Frame::Type::UNSET);
+  }
+
+  if (first.empty())
+  {
+    std::swap(first, second);
+  }
+
+  const auto last = second.empty() ? first.back() : second.back();
+  if (first.front() != protocol_bytes::frame_boundary || last != protocol_bytes::frame_boundary)
+  {
+    return Frame(Frame::Type::UNSET);
+  }
+
+  // Strip the boundaries.
+  first = first.subspan(1);
+  if (second.empty())
+    first = first.first(first.size() - 1);
+  else
+    second = second.first(second.size() - 1);
+
+  unescape_sink<fcs_t> sink(size - frame_min_size, field);
+  bool                 escaped = false;
+
+  for (const auto segment : {first, second})
+  {
+    auto       it  = segment.begin();
+    const auto end = segment.end();
+
+    // An escape may have been split across the wrap.
+    if (escaped && it != end)
+    {
+      const uint8_t byte = *it++ ^ (uint8_t)header_bits::stuffing;
+      sink.append(&byte, 1);
+      escaped = false;
     }
-  });
 
-  return descaped;
+    while (it != end)
+    {
+      const auto run = stuffing::find_escape(it, end);
+      sink.append(it, run - it);
+      if (run == end)
+        break;
+
+      if (run + 1 == end)
+      {
+        escaped = true;
+        break;
+      }
+
+      const uint8_t byte = run[1] ^ (uint8_t)header_bits::stuffing;
+      sink.append(&byte, 1);
+      it = run + 2;
+    }
+  }
+
+  // A trailing escape is the abort sequence.
+  if (escaped || !sink.valid())
+  {
+    return Frame(Frame::Type::UNSET);
+  }
+
+  return make_frame(sink.address(), sink.control(), sink.payload());
+}
+
+template <typename fcs_t>
+FrameView BasicFrameSerializer<fcs_t>::decode_view(span<const uint8_t> first, span<const uint8_t> second, span<uint8_t> storage,
+                                                  const ControlField field)
+{
+  if (storage.size() < first.size() + second.size())
+  {
+    return FrameView();
+  }
+
+  // The boundaries are never escaped so they pass through unchanged. An abort
+  // sequence swallows the closing boundary and fails the parse.
+  bool pending = false;
+  auto out     = stuffing::unescape(first.begin(), first.end(), storage.begin(), pending);
+  out          = stuffing::unescape(second.begin(), second.end(), out, pending);
+
+  return parse(span<const uint8_t>(storage.begin(), out), field);
 }
 
+template <typename fcs_t>
+size_t BasicFrameSerializer<fcs_t>::descape_into(span<const uint8_t> buffer, uint8_t *out)
+{
+  // The escape state lives on the stack so concurrent calls do not interfere
+  // and a trailing escape does not leak into the next buffer.
+  bool       pending = false;
+  const auto end     = stuffing::unescape(buffer.begin(), buffer.end(), out, pending);
+  return end - out;
+}
+
+template <typename fcs_t>
 template <typename iterator_t>
-auto FrameSerializer::checksum(iterator_t begin, iterator_t end)
+typename BasicFrameSerializer<fcs_t>::checksum_type BasicFrameSerializer<fcs_t>::checksum(iterator_t begin, iterator_t end)
 {
-  crc_ccitt.reset();
-  crc_ccitt.process_block(&*begin, &*end);
-  return crc_ccitt.checksum();
+  using crc_t = typename fcs_t::crc_type;
+
+  if (begin == end)
+    return crc_t::finalize(crc_t::initial);
+
+  const uint8_t *data = &*begin;
+  return crc_t::compute(data, data + (end - begin));
 }
 
-auto FrameSerializer::checksum(std::vector<uint8_t> &frame) { return checksum(frame.begin(), frame.end()); }
+template <typename fcs_t>
+typename BasicFrameSerializer<fcs_t>::checksum_type BasicFrameSerializer<fcs_t>::checksum(std::vector<uint8_t> &frame)
+{
+  return checksum(frame.begin(), frame.end());
+}
 
-void FrameSerializer::append_checksum(std::vector<uint8_t> &buffer)
+template <typename fcs_t>
+void BasicFrameSerializer<fcs_t>::append_checksum(std::vector<uint8_t> &buffer)
 {
   // Skip over the first byte since we assume it is a frame boundary.
   const auto crc = checksum(buffer.begin() + 1, buffer.end());
-  buffer.emplace_back(crc & 0xFF);
-  buffer.emplace_back(crc >> 8);
+  fcs_t::write(crc, std::back_inserter(buffer));
 }
 
+template <typename fcs_t>
 template <typename iterator_t>
-bool FrameSerializer::is_checksum_valid(iterator_t begin, iterator_t end)
+bool BasicFrameSerializer<fcs_t>::is_checksum_valid(iterator_t begin, iterator_t end)
 {
-  if ((end - begin) < FRAME_MIN_SIZE)
+  if ((end - begin) < static_cast<std::ptrdiff_t>(frame_min_size))
     return false;
 
+  // Skip the frame boundaries, the FCS sits just before the closing flag.
   auto expected_begin    = begin + 1;
-  auto expected_end      = end - 3;
+  auto expected_end      = end - (fcs_t::size + 1);
   auto expected_checksum = checksum(expected_begin, expected_end);
-  auto actual_checksum   = *(end - 3) | (*(end - 2) << 8);
+  auto actual_checksum   = fcs_t::read(expected_end);
   return expected_checksum == actual_checksum;
 }
 
-bool FrameSerializer::is_checksum_valid(std::vector<uint8_t> &buffer) { return is_checksum_valid(buffer.begin(), buffer.end()); }
+template <typename fcs_t>
+bool BasicFrameSerializer<fcs_t>::is_checksum_valid(std::vector<uint8_t> &buffer)
+{
+  return is_checksum_valid(buffer.begin(), buffer.end());
+}
+
+template class BasicFrameSerializer<fcs16>;
+template class BasicFrameSerializer<fcs32>;
 
 } // namespace hdlc
@@ -39,6 +39,9 @@ std::ostream& operator<<(std::ostream& os, const Frame::Type& type)
   case Frame::Type::SNRM: os << "set normal response mode"; break;
   case Frame::Type::NR1: os << "nonreserved1"; break;
   case Frame::Type::NR3: os << "nonreserved3"; break;
+  case Frame::Type::SARME: os << "set asynchronous response mode extended"; break;
+  case Frame::Type::SNRME: os << "set normal response mode extended"; break;
+  case Frame::Type::SABME: os << "set asynchronous balanced mode extended"; break;
   case Frame::Type::TEST: os << "test"; break;
   case Frame::Type::UNSET: os << "unset"; break;
   default: assert(0);
@@ -72,7 +75,7 @@ std::ostream& operator<<(std::ostream& os, const Frame& f)
 
     if (f.has_payload())
     {
-      const auto payload = f.get_payload();
+      const auto& payload = f.get_payload();
       os << fmt::format(", {} bytes : ", payload.size());
       for (const auto byte : payload)
       {
@@ -115,6 +118,17 @@ std::ostream& operator<<(std::ostream& os, const ConnectionStatus& status)
   return os;
 }
 
+std::ostream& operator<<(std::ostream& os, const ControlField& field)
+{
+  switch (field)
+  {
+  case ControlField::Basic: os << "Basic"; break;
+  case ControlField::Extended: os << "Extended"; break;
+  default: os << "Unknown"; break;
+  }
+  return os;
+}
+
 } // namespace hdlc
 
 #endif
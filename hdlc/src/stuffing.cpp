@@ -0,0 +1,178 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include "hdlc/stuffing.h"
+
+#include <algorithm>
+#include <string.h>
+
+namespace hdlc
+{
+namespace stuffing
+{
+
+namespace
+{
+/**
+ * @brief      Function pointers picked once for this CPU.
+ */
+struct dispatch_table
+{
+  kernel type;
+  const uint8_t* (*find_special)(const uint8_t*, const uint8_t*) noexcept;
+  size_t (*count_special)(const uint8_t*, const uint8_t*) noexcept;
+  const uint8_t* (*find_escape)(const uint8_t*, const uint8_t*) noexcept;
+  const uint8_t* (*find_flag)(const uint8_t*, const uint8_t*) noexcept;
+};
+
+dispatch_table select_kernels(void) noexcept
+{
+#if HDLC_USE_X86_SIMD
+  if (detail::avx2_supported())
+  {
+    return {kernel::avx2, detail::find_special_avx2, detail::count_special_avx2, detail::find_escape_avx2, detail::find_flag_avx2};
+  }
+  return {kernel::sse2, detail::find_special_sse2, detail::count_special_sse2, detail::find_escape_sse2, detail::find_flag_sse2};
+#else
+  return {kernel::scalar, find_special_scalar, count_special_scalar, find_escape_scalar, find_flag_scalar};
+#endif
+}
+
+const dispatch_table& kernels(void) noexcept
+{
+  static const dispatch_table k = select_kernels();
+  return k;
+}
+} // namespace
+
+kernel active_kernel(void) noexcept { return kernels().type; }
+
+const uint8_t* find_special(const uint8_t* begin, const uint8_t* end) noexcept { return kernels().find_special(begin, end); }
+
+size_t count_special(const uint8_t* begin, const uint8_t* end) noexcept { return kernels().count_special(begin, end); }
+
+const uint8_t* find_escape(const uint8_t* begin, const uint8_t* end) noexcept { return kernels().find_escape(begin, end); }
+
+const uint8_t* find_flag(const uint8_t* begin, const uint8_t* end) noexcept { return kernels().find_flag(begin, end); }
+
+/*
+ * Dense data has special bytes every few bytes, where handing each short run to
+ * the vector kernel costs more than it saves. Both loops below walk up to a
+ * probe's worth of bytes one at a time first and only call the kernel once
+ * that many clean bytes have been seen in a row. The serializer's escape writer
+ * does the same.
+ */
+
+uint8_t* escape(const uint8_t* begin, const uint8_t* end, uint8_t* out) noexcept
+{
+  const auto& k = kernels();
+
+  while (begin != end)
+  {
+    const auto probe = begin + std::min(end - begin, probe_size);
+    while (begin != probe && !is_special(*begin))
+    {
+      *out++ = *begin++;
+    }
+
+    if (begin == probe)
+    {
+      const auto run = k.find_special(begin, end);
+      memcpy(out, begin, run - begin);
+      out += run - begin;
+      begin = run;
+      if (begin == end)
+        break;
+    }
+
+    *out++ = protocol_bytes::escape;
+    *out++ = *begin++ ^ (uint8_t)header_bits::stuffing;
+  }
+
+  return out;
+}
+
+uint8_t* unescape(const uint8_t* begin, const uint8_t* end, uint8_t* out, bool& pending) noexcept
+{
+  const auto& k = kernels();
+
+  if (pending && begin != end)
+  {
+    *out++  = *begin++ ^ (uint8_t)header_bits::stuffing;
+    pending = false;
+  }
+
+  while (begin != end)
+  {
+    const auto probe = begin + std::min(end - begin, probe_size);
+    while (begin != probe && *begin != protocol_bytes::escape)
+    {
+      *out++ = *begin++;
+    }
+
+    if (begin == probe)
+    {
+      const auto run = k.find_escape(begin, end);
+      memmove(out, begin, run - begin);
+      out += run - begin;
+      begin = run;
+      if (begin == end)
+        break;
+    }
+
+    if (begin + 1 == end)
+    {
+      pending = true;
+      break;
+    }
+
+    *out++ = begin[1] ^ (uint8_t)header_bits::stuffing;
+    begin += 2;
+  }
+
+  return out;
+}
+
+const uint8_t* find_special_scalar(const uint8_t* begin, const uint8_t* end) noexcept
+{
+  while (begin != end && !is_special(*begin))
+  {
+    ++begin;
+  }
+  return begin;
+}
+
+size_t count_special_scalar(const uint8_t* begin, const uint8_t* end) noexcept
+{
+  size_t count = 0;
+  while (begin != end)
+  {
+    count += is_special(*begin++) ? 1 : 0;
+  }
+  return count;
+}
+
+const uint8_t* find_escape_scalar(const uint8_t* begin, const uint8_t* end) noexcept
+{
+  while (begin != end && *begin != protocol_bytes::escape)
+  {
+    ++begin;
+  }
+  return begin;
+}
+
+const uint8_t* find_flag_scalar(const uint8_t* begin, const uint8_t* end) noexcept
+{
+  while (begin != end && *begin != protocol_bytes::frame_boundary)
+  {
+    ++begin;
+  }
+  return begin;
+}
+
+} // namespace stuffing
+} // namespace hdlc
@@ -0,0 +1,213 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include "hdlc/stuffing.h"
+
+#if HDLC_USE_X86_SIMD
+
+#include <algorithm>
+#include <immintrin.h>
+
+#define HDLC_AVX2_TARGET __attribute__((target("avx2")))
+
+namespace hdlc
+{
+namespace stuffing
+{
+namespace detail
+{
+
+/*
+ * Each block is compared against the flag and escape bytes and the result is
+ * turned into a bit mask with one bit per byte, so the position of the first
+ * match is the number of trailing zeros. Inputs shorter than a register go to
+ * the scalar kernel. The last partial block is handled by loading the final
+ * full register of the input, which overlaps bytes already known to be
+ * clean. Counting cannot overlap, so there the mask of the final register is
+ * shifted to drop the bytes that were already counted.
+ *
+ * Counting accumulates the compare results (0 or -1 per byte) in byte lanes
+ * and widens them with a sum of absolute differences every 255 blocks before
+ * a lane can overflow.
+ */
+
+namespace
+{
+inline __m128i special_sse2(const __m128i v)
+{
+  return _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(protocol_bytes::frame_boundary)),
+                      _mm_cmpeq_epi8(v, _mm_set1_epi8(protocol_bytes::escape)));
+}
+
+inline __m128i escape_sse2(const __m128i v) { return _mm_cmpeq_epi8(v, _mm_set1_epi8(protocol_bytes::escape)); }
+
+inline __m128i flag_sse2(const __m128i v) { return _mm_cmpeq_epi8(v, _mm_set1_epi8(protocol_bytes::frame_boundary)); }
+
+inline __m128i load_sse2(const uint8_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+
+inline uint32_t mask_sse2(const __m128i v) { return static_cast<uint32_t>(_mm_movemask_epi8(v)); }
+
+template <__m128i (*match)(__m128i)>
+const uint8_t* find_sse2(const uint8_t* begin, const uint8_t* end) noexcept
+{
+  const auto last = end - 16;
+  while (begin < last)
+  {
+    if (const auto m = mask_sse2(match(load_sse2(begin))))
+      return begin + __builtin_ctz(m);
+    begin += 16;
+  }
+
+  const auto m = mask_sse2(match(load_sse2(last)));
+  return m ? last + __builtin_ctz(m) : end;
+}
+
+HDLC_AVX2_TARGET inline __m256i special_avx2(const __m256i v)
+{
+  return _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(protocol_bytes::frame_boundary)),
+                         _mm256_cmpeq_epi8(v, _mm256_set1_epi8(protocol_bytes::escape)));
+}
+
+HDLC_AVX2_TARGET inline __m256i escape_avx2(const __m256i v) { return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(protocol_bytes::escape)); }
+
+HDLC_AVX2_TARGET inline __m256i flag_avx2(const __m256i v)
+{
+  return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(protocol_bytes::frame_boundary));
+}
+
+HDLC_AVX2_TARGET inline __m256i load_avx2(const uint8_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+
+HDLC_AVX2_TARGET inline uint32_t mask_avx2(const __m256i v) { return static_cast<uint32_t>(_mm256_movemask_epi8(v)); }
+
+template <__m256i (*match)(__m256i)>
+HDLC_AVX2_TARGET const uint8_t* find_avx2(const uint8_t* begin, const uint8_t* end) noexcept
+{
+  const auto last = end - 32;
+  while (begin < last)
+  {
+    if (const auto m = mask_avx2(match(load_avx2(begin))))
+      return begin + __builtin_ctz(m);
+    begin += 32;
+  }
+
+  const auto m = mask_avx2(match(load_avx2(last)));
+  return m ? last + __builtin_ctz(m) : end;
+}
+} // namespace
+
+bool avx2_supported(void) noexcept
+{
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+const uint8_t* find_special_sse2(const uint8_t* begin, const uint8_t* end) noexcept
+{
+  if ((end - begin) < 16)
+    return find_special_scalar(begin, end);
+  return find_sse2<special_sse2>(begin, end);
+}
+
+const uint8_t* find_escape_sse2(const uint8_t* begin, const uint8_t* end) noexcept
+{
+  if ((end - begin) < 16)
+    return find_escape_scalar(begin, end);
+  return find_sse2<escape_sse2>(begin, end);
+}
+
+const uint8_t* find_flag_sse2(const uint8_t* begin, const uint8_t* end) noexcept
+{
+  if ((end - begin) < 16)
+    return find_flag_scalar(begin, end);
+  return find_sse2<flag_sse2>(begin, end);
+}
+
+size_t count_special_sse2(const uint8_t* begin, const uint8_t* end) noexcept
+{
+  if ((end - begin) < 16)
+    return count_special_scalar(begin, end);
+
+  size_t     count = 0;
+  const auto zero  = _mm_setzero_si128();
+
+  while ((end - begin) >= 16)
+  {
+    auto       acc    = zero;
+    const auto blocks = std::min<size_t>((end - begin) / 16, 255);
+    for (size_t i = 0; i < blocks; ++i, begin += 16)
+    {
+      acc = _mm_sub_epi8(acc, special_sse2(load_sse2(begin)));
+    }
+    const auto sums = _mm_sad_epu8(acc, zero);
+    count += static_cast<size_t>(_mm_cvtsi128_si64(sums)) + static_cast<size_t>(_mm_extract_epi16(sums, 4));
+  }
+
+  if (begin != end)
+  {
+    const auto m = mask_sse2(special_sse2(load_sse2(end - 16))) >> (16 - (end - begin));
+    count += static_cast<size_t>(__builtin_popcount(m));
+  }
+
+  return count;
+}
+
+HDLC_AVX2_TARGET const uint8_t* find_special_avx2(const uint8_t* begin, const uint8_t* end) noexcept
+{
+  if ((end - begin) < 32)
+    return find_special_sse2(begin, end);
+  return find_avx2<special_avx2>(begin, end);
+}
+
+HDLC_AVX2_TARGET const uint8_t* find_escape_avx2(const uint8_t* begin, const uint8_t* end) noexcept
+{
+  if ((end - begin) < 32)
+    return find_escape_sse2(begin, end);
+  return find_avx2<escape_avx2>(begin, end);
+}
+
+HDLC_AVX2_TARGET const uint8_t* find_flag_avx2(const uint8_t* begin, const uint8_t* end) noexcept
+{
+  if ((end - begin) < 32)
+    return find_flag_sse2(begin, end);
+  return find_avx2<flag_avx2>(begin, end);
+}
+
+HDLC_AVX2_TARGET size_t count_special_avx2(const uint8_t* begin, const uint8_t* end) noexcept
+{
+  if ((end - begin) < 32)
+    return count_special_sse2(begin, end);
+
+  size_t     count = 0;
+  const auto zero  = _mm256_setzero_si256();
+
+  while ((end - begin) >= 32)
+  {
+    auto       acc    = zero;
+    const auto blocks = std::min<size_t>((end - begin) / 32, 255);
+    for (size_t i = 0; i < blocks; ++i, begin += 32)
+    {
+      acc = _mm256_sub_epi8(acc, special_avx2(load_avx2(begin)));
+    }
+    const auto sums = _mm256_sad_epu8(acc, zero);
+    count += static_cast<size_t>(_mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) + _mm256_extract_epi64(sums, 2) +
+                                 _mm256_extract_epi64(sums, 3));
+  }
+
+  if (begin != end)
+  {
+    const auto m = mask_avx2(special_avx2(load_avx2(end - 32))) >> (32 - (end - begin));
+    count += static_cast<size_t>(__builtin_popcount(m));
+  }
+
+  return count;
+}
+
+} // namespace detail
+} // namespace stuffing
+} // namespace hdlc
+
+#endif
@@ -0,0 +1,113 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include "hdlc/tty_io.h"
+
+#if HDLC_USE_EPOLL
+
+#include <fcntl.h>
+#include <linux/serial.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace hdlc
+{
+namespace tty
+{
+
+namespace
+{
+bool to_speed(const uint32_t baud, speed_t& speed) noexcept
+{
+  switch (baud)
+  {
+  case 9600: speed = B9600; return true;
+  case 19200: speed = B19200; return true;
+  case 38400: speed = B38400; return true;
+  case 57600: speed = B57600; return true;
+  case 115200: speed = B115200; return true;
+  case 230400: speed = B230400; return true;
+  case 460800: speed = B460800; return true;
+  case 500000: speed = B500000; return true;
+  case 576000: speed = B576000; return true;
+  case 921600: speed = B921600; return true;
+  case 1000000: speed = B1000000; return true;
+  case 1152000: speed = B1152000; return true;
+  case 1500000: speed = B1500000; return true;
+  case 2000000: speed = B2000000; return true;
+  case 2500000: speed = B2500000; return true;
+  case 3000000: speed = B3000000; return true;
+  case 3500000: speed = B3500000; return true;
+  case 4000000: speed = B4000000; return true;
+  default: return false;
+  }
+}
+} // namespace
+
+int open(const char* path, const settings& s)
+{
+  // Without O_NONBLOCK the open waits for carrier detect until CLOCAL is
+  // set, which a line without modem control never raises.
+  const auto fd = ::open(path, O_RDWR | O_NOCTTY | O_CLOEXEC | O_NONBLOCK);
+  if (fd < 0)
+    return -1;
+
+  const auto flags = ::fcntl(fd, F_GETFL);
+  if (!configure(fd, s) || flags < 0 || (!s.non_blocking && ::fcntl(fd, F_SETFL, flags & ~O_NONBLOCK) < 0))
+  {
+    ::close(fd);
+    return -1;
+  }
+
+  if (s.low_latency)
+    set_low_latency(fd, true);
+
+  return fd;
+}
+
+bool configure(const int fd, const settings& s)
+{
+  speed_t speed;
+  termios tio;
+  if (!to_speed(s.baud, speed) || ::tcgetattr(fd, &tio) < 0)
+    return false;
+
+  ::cfmakeraw(&tio);
+  tio.c_cflag |= CLOCAL | CREAD;
+  tio.c_cflag &= ~(CSTOPB | PARENB);
+  if (s.hardware_flow)
+    tio.c_cflag |= CRTSCTS;
+  else
+    tio.c_cflag &= ~CRTSCTS;
+  tio.c_iflag &= ~(IXON | IXOFF | IXANY);
+  tio.c_cc[VMIN]  = s.vmin;
+  tio.c_cc[VTIME] = s.vtime;
+
+  if (::cfsetispeed(&tio, speed) < 0 || ::cfsetospeed(&tio, speed) < 0)
+    return false;
+
+  return ::tcsetattr(fd, TCSANOW, &tio) == 0 && ::tcflush(fd, TCIOFLUSH) == 0;
+}
+
+bool set_low_latency(const int fd, const bool enable)
+{
+  serial_struct serial;
+  if (::ioctl(fd, TIOCGSERIAL, &serial) < 0)
+    return false;
+
+  if (enable)
+    serial.flags |= ASYNC_LOW_LATENCY;
+  else
+    serial.flags &= ~ASYNC_LOW_LATENCY;
+  return ::ioctl(fd, TIOCSSERIAL, &serial) == 0;
+}
+
+} // namespace tty
+} // namespace hdlc
+
+#endif
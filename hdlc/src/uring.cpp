@@ -0,0 +1,511 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#include "hdlc/uring_io.h"
+
+#if HDLC_USE_IO_URING
+
+#include <algorithm>
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace hdlc
+{
+
+namespace
+{
+// The low bits of the user data say what a completion is for, links are at
+// least pointer aligned.
+constexpr uint64_t tag_mask   = 0b111;
+constexpr uint64_t tag_read   = 0;
+constexpr uint64_t tag_write  = 1;
+constexpr uint64_t tag_wake   = 2;
+constexpr uint64_t tag_cancel = 3;
+
+// How long remove() waits before posting its cancels again.
+constexpr int cancel_retry_ms = 10;
+
+uint64_t user_data(const uring_link& link, const uint64_t tag) noexcept { return reinterpret_cast<uintptr_t>(&link) | tag; }
+
+int io_uring_setup(const unsigned entries, io_uring_params& params) noexcept
+{
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int io_uring_enter(const int ring, const unsigned to_submit, const unsigned min_complete, const unsigned flags, const void* arg,
+                   const size_t arg_size) noexcept
+{
+  return static_cast<int>(::syscall(__NR_io_uring_enter, ring, to_submit, min_complete, flags, arg, arg_size));
+}
+
+int io_uring_register(const int ring, const unsigned opcode, const void* arg, const unsigned count) noexcept
+{
+  return static_cast<int>(::syscall(__NR_io_uring_register, ring, opcode, arg, count));
+}
+
+size_t round_up_pow2(size_t value) noexcept
+{
+  size_t pow2 = 1;
+  while (pow2 < value) pow2 <<= 1;
+  return pow2;
+}
+} // namespace
+
+struct uring_reactor::sqe_ring
+{
+  void*         map       = MAP_FAILED;
+  size_t        map_size  = 0;
+  unsigned*     head      = nullptr;
+  unsigned*     tail      = nullptr;
+  unsigned      mask      = 0;
+  unsigned      entries   = 0;
+  unsigned*     array     = nullptr;
+  io_uring_sqe* sqes      = nullptr;
+  size_t        sqes_size = 0;
+};
+
+struct uring_reactor::cqe_ring
+{
+  void*         map      = MAP_FAILED;
+  size_t        map_size = 0;
+  unsigned*     head     = nullptr;
+  unsigned*     tail     = nullptr;
+  unsigned      mask     = 0;
+  io_uring_cqe* cqes     = nullptr;
+};
+
+void uring_link::queue_out(void) noexcept
+{
+  // Orders the queued bytes before the flag, pairs with the fence after the
+  // reactor clears it.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_reactor && m_out_signalled.exchange(true) == false)
+    m_reactor->wake();
+}
+
+uring_reactor::uring_reactor(const size_t max_links) : m_links(max_links, nullptr), m_sq(new sqe_ring), m_cq(new cqe_ring)
+{
+  // A read and a write per link, the wake up read and a few cancellations.
+  const auto      entries = static_cast<unsigned>(round_up_pow2(2 * max_links + 8));
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  // Completions are only run when the reactor enters the kernel instead of
+  // interrupting it, so they pile up and are reaped together. Needs 5.19.
+  params.flags = IORING_SETUP_COOP_TASKRUN | IORING_SETUP_SUBMIT_ALL;
+  m_ring       = io_uring_setup(entries, params);
+  if (m_ring < 0)
+  {
+    memset(&params, 0, sizeof(params));
+    m_ring = io_uring_setup(entries, params);
+  }
+  if (m_ring < 0)
+    return;
+
+  auto&      sq         = *m_sq;
+  auto&      cq         = *m_cq;
+  const bool single_map = params.features & IORING_FEAT_SINGLE_MMAP;
+  sq.map_size           = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq.map_size           = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  if (single_map)
+    sq.map_size = cq.map_size = std::max(sq.map_size, cq.map_size);
+
+  sq.map = ::mmap(nullptr, sq.map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_SQ_RING);
+  if (sq.map != MAP_FAILED)
+    cq.map = single_map ? sq.map : ::mmap(nullptr, cq.map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_CQ_RING);
+  sq.sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+  if (cq.map != MAP_FAILED)
+    sq.sqes = static_cast<io_uring_sqe*>(
+        ::mmap(nullptr, sq.sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_SQES));
+
+  m_event = ::eventfd(0, EFD_CLOEXEC);
+  if (sq.map == MAP_FAILED || cq.map == MAP_FAILED || sq.sqes == MAP_FAILED || m_event < 0)
+  {
+    if (sq.sqes == MAP_FAILED)
+      sq.sqes = nullptr;
+    ::close(m_ring);
+    m_ring = -1;
+    return;
+  }
+
+  const auto sq_base = static_cast<uint8_t*>(sq.map);
+  sq.head            = reinterpret_cast<unsigned*>(sq_base + params.sq_off.head);
+  sq.tail            = reinterpret_cast<unsigned*>(sq_base + params.sq_off.tail);
+  sq.mask            = *reinterpret_cast<unsigned*>(sq_base + params.sq_off.ring_mask);
+  sq.entries         = *reinterpret_cast<unsigned*>(sq_base + params.sq_off.ring_entries);
+  sq.array           = reinterpret_cast<unsigned*>(sq_base + params.sq_off.array);
+
+  const auto cq_base = static_cast<uint8_t*>(cq.map);
+  cq.head            = reinterpret_cast<unsigned*>(cq_base + params.cq_off.head);
+  cq.tail            = reinterpret_cast<unsigned*>(cq_base + params.cq_off.tail);
+  cq.mask            = *reinterpret_cast<unsigned*>(cq_base + params.cq_off.ring_mask);
+  cq.cqes            = reinterpret_cast<io_uring_cqe*>(cq_base + params.cq_off.cqes);
+
+  // Empty slots for the pipe storage of every link, filled in by add(). Plain
+  // reads and writes are used if the kernel refuses.
+  io_uring_rsrc_register reg;
+  memset(&reg, 0, sizeof(reg));
+  reg.nr    = static_cast<uint32_t>(2 * max_links);
+  reg.flags = IORING_RSRC_REGISTER_SPARSE;
+  m_fixed   = io_uring_register(m_ring, IORING_REGISTER_BUFFERS2, &reg, sizeof(reg)) == 0;
+
+  post_wake();
+}
+
+uring_reactor::~uring_reactor()
+{
+  // Closing the ring cancels everything still posted.
+  if (m_ring >= 0)
+    ::close(m_ring);
+  if (m_event >= 0)
+    ::close(m_event);
+  if (m_sq->sqes)
+    ::munmap(m_sq->sqes, m_sq->sqes_size);
+  if (m_cq->map != MAP_FAILED && m_cq->map != m_sq->map)
+    ::munmap(m_cq->map, m_cq->map_size);
+  if (m_sq->map != MAP_FAILED)
+    ::munmap(m_sq->map, m_sq->map_size);
+  delete m_sq;
+  delete m_cq;
+}
+
+bool uring_reactor::add(uring_link& link)
+{
+  if (!is_open() || link.m_reactor)
+    return false;
+
+  size_t slot = 0;
+  while (slot < m_links.size() && m_links[slot]) ++slot;
+  if (slot == m_links.size())
+    return false;
+
+  if (m_fixed && !update_buffers(slot, link.in_storage(), link.out_storage()))
+    return false;
+
+  m_links[slot]  = &link;
+  link.m_reactor = this;
+  link.m_slot    = slot;
+  link.m_reading = link.m_writing = link.m_stalled = link.m_closed = false;
+  link.m_out_signalled.store(false);
+  ++m_count;
+
+  post_read(link);
+  // Anything queued before the link was added.
+  post_write(link);
+  return true;
+}
+
+bool uring_reactor::remove(uring_link& link)
+{
+  if (link.m_reactor != this)
+    return false;
+
+  // Cancels are posted again until the requests are gone, one may have found
+  // no free entry and a read that completes first posts another.
+  while (link.m_reading || link.m_writing)
+  {
+    if (link.m_reading)
+      post_cancel(user_data(link, tag_read));
+    if (link.m_writing)
+      post_cancel(user_data(link, tag_write));
+    run_once(cancel_retry_ms);
+  }
+
+  if (link.m_stalled)
+    --m_stalled;
+  if (m_fixed)
+    update_buffers(link.m_slot, span<uint8_t>(), span<uint8_t>());
+
+  m_links[link.m_slot] = nullptr;
+  link.m_reactor       = nullptr;
+  --m_count;
+  return true;
+}
+
+size_t uring_reactor::run_once(const int timeout_ms)
+{
+  // Links whose in pipe was full get another chance.
+  if (m_stalled)
+  {
+    for (auto link : m_links)
+      if (link && link->m_stalled)
+        post_read(*link);
+  }
+
+  const unsigned flags  = IORING_ENTER_GETEVENTS | ((timeout_ms >= 0) ? IORING_ENTER_EXT_ARG : 0);
+  __kernel_timespec      ts;
+  io_uring_getevents_arg arg;
+  memset(&arg, 0, sizeof(arg));
+  ts.tv_sec  = timeout_ms / 1000;
+  ts.tv_nsec = (timeout_ms % 1000) * 1000000L;
+  arg.ts     = reinterpret_cast<uintptr_t>(&ts);
+
+  const auto submitted = io_uring_enter(m_ring, m_pending, timeout_ms ? 1 : 0, flags, (timeout_ms >= 0) ? &arg : nullptr,
+                                        (timeout_ms >= 0) ? sizeof(arg) : 0);
+  ++m_stats.enters;
+  if (submitted > 0)
+  {
+    m_pending -= static_cast<unsigned>(submitted);
+    m_stats.submitted += static_cast<size_t>(submitted);
+  }
+
+  auto&  cq      = *m_cq;
+  size_t handled = 0;
+  auto   head    = *cq.head;
+  while (head != __atomic_load_n(cq.tail, __ATOMIC_ACQUIRE))
+  {
+    const auto& cqe = cq.cqes[head & cq.mask];
+    // Copy out before the slot is handed back to the kernel.
+    const auto data   = cqe.user_data;
+    const auto result = cqe.res;
+    __atomic_store_n(cq.head, ++head, __ATOMIC_RELEASE);
+    complete(data, result);
+    ++handled;
+  }
+
+  m_stats.completed += handled;
+  return handled;
+}
+
+void uring_reactor::run(void)
+{
+  while (m_stopping.load(std::memory_order_acquire) == false)
+  {
+    // A full in pipe is only noticed when the reactor wakes, so do not
+    // sleep for long while a link is stalled.
+    run_once(m_stalled ? 10 : -1);
+  }
+}
+
+void uring_reactor::stop(void)
+{
+  m_stopping.store(true, std::memory_order_release);
+  const uint64_t one = 1;
+  while (::write(m_event, &one, sizeof(one)) < 0 && errno == EINTR)
+  {
+  }
+}
+
+void uring_reactor::wake(void) noexcept
+{
+  if (m_wake_pending.exchange(true))
+    return;
+
+  const uint64_t one = 1;
+  while (::write(m_event, &one, sizeof(one)) < 0 && errno == EINTR)
+  {
+  }
+}
+
+void* uring_reactor::get_sqe(void)
+{
+  auto&      sq   = *m_sq;
+  const auto tail = *sq.tail;
+  if (tail - __atomic_load_n(sq.head, __ATOMIC_ACQUIRE) >= sq.entries)
+  {
+    // Full, hand what is queued to the kernel first.
+    const auto submitted = io_uring_enter(m_ring, m_pending, 0, 0, nullptr, 0);
+    ++m_stats.enters;
+    if (submitted <= 0)
+      return nullptr;
+    m_pending -= static_cast<unsigned>(submitted);
+    m_stats.submitted += static_cast<size_t>(submitted);
+  }
+
+  const auto index = tail & sq.mask;
+  auto       sqe   = &sq.sqes[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sq.array[index] = index;
+  // The kernel only looks at the queue in io_uring_enter(), which is called
+  // after the entry has been filled in.
+  __atomic_store_n(sq.tail, tail + 1, __ATOMIC_RELEASE);
+  ++m_pending;
+  return sqe;
+}
+
+void uring_reactor::post_read(uring_link& link)
+{
+  if (link.m_closed || link.m_reading)
+    return;
+
+  const auto space = link.in_space();
+  if (space.empty() != link.m_stalled)
+  {
+    link.m_stalled = space.empty();
+    if (link.m_stalled)
+      ++m_stalled;
+    else
+      --m_stalled;
+  }
+  if (space.empty())
+    return;
+
+  auto sqe = static_cast<io_uring_sqe*>(get_sqe());
+  if (sqe == nullptr)
+    return;
+
+  sqe->opcode    = m_fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+  sqe->fd        = link.native_handle();
+  sqe->addr      = reinterpret_cast<uintptr_t>(space.data());
+  sqe->len       = static_cast<uint32_t>(space.size());
+  sqe->off       = static_cast<uint64_t>(-1);
+  sqe->buf_index = static_cast<uint16_t>(2 * link.m_slot);
+  sqe->user_data = user_data(link, tag_read);
+  link.m_reading = true;
+}
+
+void uring_reactor::post_write(uring_link& link)
+{
+  if (link.m_closed || link.m_writing)
+    return;
+
+  const auto data = link.out_data();
+  if (data.empty())
+    return;
+
+  auto sqe = static_cast<io_uring_sqe*>(get_sqe());
+  if (sqe == nullptr)
+    return;
+
+  sqe->opcode    = m_fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+  sqe->fd        = link.native_handle();
+  sqe->addr      = reinterpret_cast<uintptr_t>(data.data());
+  sqe->len       = static_cast<uint32_t>(data.size());
+  sqe->off       = static_cast<uint64_t>(-1);
+  sqe->buf_index = static_cast<uint16_t>(2 * link.m_slot + 1);
+  sqe->user_data = user_data(link, tag_write);
+  link.m_writing = true;
+}
+
+void uring_reactor::post_wake(void)
+{
+  if (auto sqe = static_cast<io_uring_sqe*>(get_sqe()))
+  {
+    sqe->opcode    = IORING_OP_READ;
+    sqe->fd        = m_event;
+    sqe->addr      = reinterpret_cast<uintptr_t>(&m_wake_value);
+    sqe->len       = sizeof(m_wake_value);
+    sqe->off       = static_cast<uint64_t>(-1);
+    sqe->user_data = tag_wake;
+  }
+}
+
+void uring_reactor::post_cancel(const uint64_t target)
+{
+  if (auto sqe = static_cast<io_uring_sqe*>(get_sqe()))
+  {
+    sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+    sqe->fd        = -1;
+    sqe->addr      = target;
+    sqe->user_data = tag_cancel;
+  }
+}
+
+void uring_reactor::flush_signalled(void)
+{
+  for (auto link : m_links)
+  {
+    if (link == nullptr || link->m_writing || link->m_out_signalled.load(std::memory_order_relaxed) == false)
+      continue;
+
+    link->m_out_signalled.store(false, std::memory_order_relaxed);
+    // Pairs with the fence in queue_out(), output queued after this point
+    // either is seen below or signals again.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    post_write(*link);
+  }
+}
+
+void uring_reactor::complete(const uint64_t data, const int32_t result)
+{
+  const auto tag  = data & tag_mask;
+  auto       link = reinterpret_cast<uring_link*>(static_cast<uintptr_t>(data & ~tag_mask));
+
+  switch (tag)
+  {
+  case tag_wake:
+    m_wake_pending.store(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_stopping.load(std::memory_order_relaxed) == false)
+      post_wake();
+    flush_signalled();
+    break;
+
+  case tag_read:
+    link->m_reading = false;
+    if (result > 0)
+    {
+      link->in_commit(static_cast<size_t>(result));
+      post_read(*link);
+    }
+    else if (result == -EAGAIN || result == -EINTR)
+    {
+      post_read(*link);
+    }
+    else if (result != -ECANCELED)
+    {
+      // End of file or an error.
+      close(*link);
+    }
+    break;
+
+  case tag_write:
+    link->m_writing = false;
+    if (result == -ECANCELED)
+      break;
+    if (result < 0 && result != -EAGAIN && result != -EINTR)
+    {
+      close(*link);
+      break;
+    }
+    if (result > 0)
+      link->out_consume(static_cast<size_t>(result));
+
+    link->m_out_signalled.store(false, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    post_write(*link);
+    break;
+
+  default: break;
+  }
+}
+
+void uring_reactor::close(uring_link& link)
+{
+  link.m_closed = true;
+  if (link.m_stalled)
+  {
+    link.m_stalled = false;
+    --m_stalled;
+  }
+}
+
+bool uring_reactor::update_buffers(const size_t slot, span<uint8_t> in, span<uint8_t> out)
+{
+  iovec buffers[2];
+  buffers[0].iov_base = in.data();
+  buffers[0].iov_len  = in.size();
+  buffers[1].iov_base = out.data();
+  buffers[1].iov_len  = out.size();
+
+  io_uring_rsrc_update2 update;
+  memset(&update, 0, sizeof(update));
+  update.offset = static_cast<uint32_t>(2 * slot);
+  update.data   = reinterpret_cast<uintptr_t>(buffers);
+  update.nr     = 2;
+  return io_uring_register(m_ring, IORING_REGISTER_BUFFERS_UPDATE, &update, sizeof(update)) >= 0;
+}
+
+} // namespace hdlc
+
+#endif
@@ -6,9 +6,24 @@
  */
 
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <functional>
 #include <iostream>
+#include <mutex>
 #include <stdint.h>
 #include <string>
+#include <thread>
+
+#if HDLC_USE_EPOLL || HDLC_USE_IO_URING
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
 
 #include <fmt/format.h>
 #include <fmt/ostream.h>
@@ -16,16 +31,41 @@
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
+#include "hdlc/abm_session_peer.h"
+#include "hdlc/fd_io.h"
+#include "hdlc/tty_io.h"
+#include "hdlc/uring_io.h"
 #include "hdlc/frame_pipe.h"
 #include "hdlc/hdlc.h"
 #include "hdlc/random_frame_factory.h"
+#include "hdlc/snrm_session_client.h"
+#include "hdlc/snrm_session_master.h"
 #include "hdlc/stream_helper.h"
+#include "hdlc/stuffing.h"
+#include "link_io.h"
 #include "loopback_io.h"
 
 #define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
 
+#include <boost/crc.hpp>
 #include <catch2/catch.hpp>
 
+// Counts global allocations so tests can check hot paths do not allocate.
+static std::atomic<size_t> l_allocations(0);
+
+// Kept out of line so the compiler does not pair the inlined free() with a
+// new-expression and warn about a mismatch.
+__attribute__((noinline)) void* operator new(size_t size)
+{
+  ++l_allocations;
+  if (void* ptr = malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* ptr) noexcept { free(ptr); }
+__attribute__((noinline)) void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+
 static auto       l_log            = spdlog::stdout_color_mt("hdlc_test");
 static const auto TEST_REPEAT_LOW  = 5;
 static const auto TEST_REPEAT_HIGH = 1000;
@@ -98,6 +138,169 @@ TEST_CASE("Frame Creation")
   }
 }
 
+TEST_CASE("Small buffer")
+{
+  using buffer_t = small_buffer<8>;
+
+  SECTION("Grows from inline to heap")
+  {
+    buffer_t buffer;
+    REQUIRE(buffer.is_inline());
+    for (uint8_t i = 0; i < 20; ++i)
+    {
+      buffer.push_back(i);
+      REQUIRE(buffer.is_inline() == (i < 8));
+    }
+    REQUIRE(buffer.size() == 20);
+    for (uint8_t i = 0; i < 20; ++i)
+    {
+      REQUIRE(buffer[i] == i);
+    }
+  }
+
+  SECTION("Copy and move")
+  {
+    const std::vector<uint8_t> small = {1, 2, 3};
+    const std::vector<uint8_t> large(32, 0x55);
+
+    buffer_t a(small.begin(), small.end());
+    buffer_t b(large.begin(), large.end());
+    buffer_t c = a;
+    buffer_t d = b;
+    REQUIRE(c == small);
+    REQUIRE(d == large);
+    REQUIRE(d.data() != b.data());
+
+    const auto heap  = b.data();
+    buffer_t   moved = std::move(b);
+    REQUIRE(moved.data() == heap);
+    REQUIRE(moved == large);
+    REQUIRE(b.empty());
+    REQUIRE(b.is_inline());
+
+    a = std::move(moved);
+    REQUIRE(a == large);
+    c = d;
+    REQUIRE(c == large);
+    d = buffer_t(small.begin(), small.end());
+    REQUIRE(d == small);
+  }
+
+  SECTION("Small frames do not allocate")
+  {
+    const auto payload = std::vector<uint8_t>(HDLC_FRAME_INLINE_PAYLOAD, 0x7e);
+    const auto escaped = FrameSerializer::escape(FrameSerializer::serialize(Frame(payload, Frame::Type::I)));
+    const auto before  = l_allocations.load();
+    {
+      const Frame frame(payload.begin(), payload.end(), Frame::Type::I);
+      Frame       copy    = frame;
+      Frame       moved   = std::move(copy);
+      const auto  decoded = FrameSerializer::decode(escaped);
+      REQUIRE(decoded == moved);
+      REQUIRE(decoded.get_payload().is_inline());
+    }
+    const auto after = l_allocations.load();
+    REQUIRE(before == after);
+  }
+
+  SECTION("Large frames allocate once on decode")
+  {
+    const auto payload = std::vector<uint8_t>(HDLC_FRAME_INLINE_PAYLOAD + 1, 0x7e);
+    const auto escaped = FrameSerializer::escape(FrameSerializer::serialize(Frame(payload, Frame::Type::I)));
+    {
+      // Leaves a block in this thread's pool.
+      const auto warm_up = FrameSerializer::decode(escaped);
+    }
+    pool::reset_thread_statistics();
+    const auto before  = l_allocations.load();
+    const auto decoded = FrameSerializer::decode(escaped);
+    const auto after   = l_allocations.load();
+    REQUIRE(decoded.get_payload() == payload);
+#if HDLC_USE_FRAME_POOL
+    REQUIRE(after == before);
+    REQUIRE(pool::thread_statistics().hits == 1);
+#else
+    REQUIRE(after - before == 1);
+#endif
+  }
+}
+
+TEST_CASE("Pool")
+{
+  SECTION("Size classes")
+  {
+    REQUIRE(pool::size_class(1) == 0);
+    REQUIRE(pool::size_class(32) == 0);
+    REQUIRE(pool::size_class(33) == 1);
+    REQUIRE(pool::size_class(64) == 1);
+    REQUIRE(pool::size_class(65) == 2);
+    REQUIRE(pool::size_class(4096) == pool::class_count - 1);
+    REQUIRE(pool::size_class(4097) == pool::class_count);
+  }
+
+  SECTION("Hits and misses")
+  {
+    pool::reset_thread_statistics();
+    std::vector<void*> blocks;
+    for (auto i = 0; i < HDLC_POOL_MAX_FREE + 8; ++i)
+    {
+      blocks.push_back(pool::allocate(1000));
+    }
+    const auto misses = pool::thread_statistics().misses;
+    for (const auto block : blocks)
+    {
+      pool::deallocate(block, 1000);
+    }
+
+    // Blocks beyond the cap go back to the heap.
+    REQUIRE(pool::thread_statistics().releases >= 8);
+
+    const auto before = l_allocations.load();
+    for (auto i = 0; i < HDLC_POOL_MAX_FREE; ++i)
+    {
+      blocks[i] = pool::allocate(600 + i);
+    }
+    REQUIRE(l_allocations.load() == before);
+    REQUIRE(pool::thread_statistics().hits == HDLC_POOL_MAX_FREE);
+    REQUIRE(pool::thread_statistics().misses == misses);
+    for (auto i = 0; i < HDLC_POOL_MAX_FREE; ++i)
+    {
+      pool::deallocate(blocks[i], 600 + i);
+    }
+
+    // Too large for any class.
+    const auto large = pool::allocate(pool::largest_class + 1);
+    pool::deallocate(large, pool::largest_class + 1);
+    REQUIRE(pool::thread_statistics().misses == misses + 1);
+  }
+
+  SECTION("Blocks freed on another thread")
+  {
+    auto block = pool::allocate(100);
+    std::thread([&block] { pool::deallocate(block, 100); }).join();
+    pool::deallocate(pool::allocate(100), 100);
+  }
+
+  SECTION("Codec buffers")
+  {
+    FramePipe pipe(4096);
+    for (auto runs = 0; runs < TEST_REPEAT_HIGH; ++runs)
+    {
+      const auto frame   = RandomFrameFactory::make();
+      const auto raw     = FrameSerializer::serialize<pool::allocator<uint8_t>>(frame);
+      const auto escaped = FrameSerializer::escape(raw);
+      const auto expected = FrameSerializer::escape(FrameSerializer::serialize(frame));
+      REQUIRE(std::equal(escaped.begin(), escaped.end(), expected.begin(), expected.end()));
+      REQUIRE(FrameSerializer::descape(escaped) == raw);
+      REQUIRE(FrameSerializer::deserialize(raw) == frame);
+
+      pipe.write(escaped);
+      const pool::buffer out = pipe.read_frame<pool::allocator<uint8_t>>();
+      REQUIRE(out == escaped);
+    }
+  }
+}
+
 TEST_CASE("Frame Serializer")
 {
   SECTION("De-escape & decode")
@@ -113,6 +316,484 @@ TEST_CASE("Frame Serializer")
       REQUIRE(frame == FrameSerializer::deserialize(FrameSerializer::descape(escaped_bytes)));
     }
   }
+
+  SECTION("32 bit FCS")
+  {
+    const auto payload = std::string("PAYLOAD");
+    Frame      frame(payload, Frame::Type::I, true, 0x11, 1, 2);
+    auto       bytes = FrameSerializer32::serialize(frame);
+    const auto crc   = crc::crc32::compute(bytes.data() + 1, bytes.data() + 3 + payload.size());
+
+    REQUIRE(FrameSerializer32::frame_min_size == 8);
+    REQUIRE(bytes.size() == (payload.size() + FrameSerializer32::frame_min_size));
+    REQUIRE(bytes.front() == protocol_bytes::frame_boundary);
+    REQUIRE(bytes.back() == protocol_bytes::frame_boundary);
+    REQUIRE(fcs32::read(bytes.end() - 5) == crc);
+    REQUIRE(FrameSerializer32::is_checksum_valid(bytes));
+    REQUIRE(frame == FrameSerializer32::deserialize(bytes));
+
+    // The FCS width is part of the link configuration, the other width must
+    // not decode.
+    REQUIRE(FrameSerializer::deserialize(bytes).is_empty());
+    REQUIRE(FrameSerializer32::deserialize(FrameSerializer::serialize(frame)).is_empty());
+
+    bytes[4] ^= 1;
+    REQUIRE(FrameSerializer32::deserialize(bytes).is_empty());
+  }
+
+  SECTION("Single pass encoder")
+  {
+    std::vector<uint8_t> out(4096);
+    for (auto runs = 0; runs < TEST_REPEAT_HIGH; ++runs)
+    {
+      const auto frame    = RandomFrameFactory::make();
+      const auto expected = FrameSerializer::escape(FrameSerializer::serialize(frame));
+      REQUIRE(FrameSerializer::encode(frame, span<uint8_t>(out)) == expected.size());
+      REQUIRE(std::equal(expected.begin(), expected.end(), out.begin()));
+
+      const auto expected32 = FrameSerializer32::escape(FrameSerializer32::serialize(frame));
+      REQUIRE(FrameSerializer32::encode(frame, span<uint8_t>(out)) == expected32.size());
+      REQUIRE(std::equal(expected32.begin(), expected32.end(), out.begin()));
+
+      // Split the output at a random point as if wrapping around a ring.
+      const auto split = RandomFrameFactory::get_random(0, expected.size() - 1);
+      span<uint8_t> all(out);
+      REQUIRE(FrameSerializer::encode(frame, all.first(split), all.subspan(split, expected.size() - split)) == expected.size());
+      REQUIRE(std::equal(expected.begin(), expected.end(), out.begin()));
+
+      // One byte short must fail.
+      REQUIRE(FrameSerializer::encode(frame, all.first(split), all.subspan(split, expected.size() - split - 1)) == 0);
+    }
+  }
+
+  SECTION("Gathered payload")
+  {
+    for (auto runs = 0; runs < TEST_REPEAT_HIGH; ++runs)
+    {
+      const auto frame    = RandomFrameFactory::make();
+      const auto expected = FrameSerializer::escape(FrameSerializer::serialize(frame));
+
+      // Cut the payload into up to four parts, some of them empty.
+      std::array<span<const uint8_t>, 4> parts;
+      span<const uint8_t>                rest(frame.get_payload().data(), frame.payload_size());
+      for (auto& part : parts)
+      {
+        part = rest.first(RandomFrameFactory::get_random(0, rest.size()));
+        rest = rest.subspan(part.size());
+      }
+      parts.back() = span<const uint8_t>(parts.back().begin(), rest.end());
+
+      std::vector<uint8_t> out(expected.size() + 8);
+      const auto           split = RandomFrameFactory::get_random(0, expected.size());
+      span<uint8_t>        all(out);
+      const auto           before = l_allocations.load();
+      const auto           size   = FrameSerializer::encode(FrameView(frame), parts, all.first(split), all.subspan(split));
+      REQUIRE(l_allocations.load() == before);
+      REQUIRE(size == expected.size());
+      REQUIRE(std::equal(expected.begin(), expected.end(), out.begin()));
+    }
+  }
+
+  SECTION("Single pass decoder")
+  {
+    for (auto runs = 0; runs < TEST_REPEAT_HIGH; ++runs)
+    {
+      const auto frame   = RandomFrameFactory::make();
+      const auto escaped = FrameSerializer::escape(FrameSerializer::serialize(frame));
+      const auto decoded = FrameSerializer::decode(escaped);
+      REQUIRE(decoded == frame);
+      REQUIRE(decoded.get_address() == frame.get_address());
+      REQUIRE(decoded == FrameSerializer::deserialize(FrameSerializer::descape(escaped)));
+
+      const auto escaped32 = FrameSerializer32::escape(FrameSerializer32::serialize(frame));
+      REQUIRE(FrameSerializer32::decode(escaped32) == frame);
+
+      // Split at a random point as if the frame wrapped around a ring.
+      const auto          split = RandomFrameFactory::get_random(0, escaped.size());
+      span<const uint8_t> all(escaped);
+      REQUIRE(FrameSerializer::decode(all.first(split), all.subspan(split)) == frame);
+    }
+  }
+
+  SECTION("Single pass decoder - escapes across the split")
+  {
+    const auto frame   = Frame(std::vector<uint8_t>({0x7e, 0x7d, 0x7e, 0x7d, 1, 0x7d}), Frame::Type::UI, true, 0x7e);
+    const auto escaped = FrameSerializer::escape(FrameSerializer::serialize(frame));
+    span<const uint8_t> all(escaped);
+    for (size_t split = 0; split <= escaped.size(); ++split)
+    {
+      REQUIRE(FrameSerializer::decode(all.first(split), all.subspan(split)) == frame);
+    }
+  }
+
+  SECTION("Single pass decoder - invalid frames")
+  {
+    const auto frame   = Frame(std::vector<uint8_t>({1, 2, 3, 4}), Frame::Type::I);
+    auto       escaped = FrameSerializer::escape(FrameSerializer::serialize(frame));
+
+    auto corrupted = escaped;
+    corrupted[4] ^= 0x01;
+    REQUIRE(FrameSerializer::decode(corrupted).is_empty());
+
+    auto aborted = escaped;
+    aborted.insert(aborted.end() - 1, protocol_bytes::escape);
+    REQUIRE(FrameSerializer::decode(aborted).is_empty());
+
+    REQUIRE(FrameSerializer::decode(span<const uint8_t>(escaped).first(5)).is_empty());
+    REQUIRE(FrameSerializer32::decode(escaped).is_empty());
+  }
+
+  SECTION("Single pass decoder - no allocation without payload")
+  {
+    const auto frame   = Frame(Frame::Type::RR, true, 0x10, 3);
+    const auto escaped = FrameSerializer::escape(FrameSerializer::serialize(frame));
+    const auto before  = l_allocations.load();
+    const auto decoded = FrameSerializer::decode(escaped);
+    const auto after   = l_allocations.load();
+    REQUIRE(decoded == frame);
+    REQUIRE(before == after);
+  }
+
+  SECTION("32 bit FCS De-escape & decode")
+  {
+    for (auto runs = 0; runs < TEST_REPEAT_HIGH; ++runs)
+    {
+      auto frame         = RandomFrameFactory::make();
+      auto bytes         = FrameSerializer32::serialize(frame);
+      auto escaped_bytes = FrameSerializer32::escape(bytes);
+      REQUIRE(bytes == FrameSerializer32::descape(escaped_bytes));
+      REQUIRE(frame == FrameSerializer32::deserialize(FrameSerializer32::descape(escaped_bytes)));
+    }
+  }
+
+  SECTION("Extended control field")
+  {
+    std::vector<uint8_t> out(4096);
+    for (auto runs = 0; runs < TEST_REPEAT_HIGH; ++runs)
+    {
+      const auto frame = RandomFrameFactory::make(ControlField::Extended);
+      const auto bytes = FrameSerializer::serialize(frame, ControlField::Extended);
+      REQUIRE(bytes.size() == FrameSerializer::serialize(frame).size() + (frame.is_unnumbered() ? 0 : 1));
+      REQUIRE(FrameSerializer::deserialize(bytes, ControlField::Extended) == frame);
+
+      const auto    escaped = FrameSerializer::escape(bytes);
+      span<uint8_t> all(out);
+      REQUIRE(FrameSerializer::encode(frame, all, span<uint8_t>(), ControlField::Extended) == escaped.size());
+      REQUIRE(std::equal(escaped.begin(), escaped.end(), out.begin()));
+
+      const auto          split = RandomFrameFactory::get_random(0, escaped.size());
+      span<const uint8_t> in(escaped);
+      REQUIRE(FrameSerializer::decode(in.first(split), in.subspan(split), ControlField::Extended) == frame);
+      const auto escaped32 = FrameSerializer32::escape(FrameSerializer32::serialize(frame, ControlField::Extended));
+      REQUIRE(FrameSerializer32::decode(escaped32, span<const uint8_t>(), ControlField::Extended) == frame);
+      REQUIRE(FrameView(frame) == FrameSerializer::decode_view(all.first(escaped.size()), ControlField::Extended));
+    }
+
+    // N(S) and the S frame type in the first byte, N(R) and P/F in the second.
+    const auto info = FrameSerializer::serialize(Frame(std::vector<uint8_t>{0x55}, Frame::Type::I, true, 0x03, 27, 100), ControlField::Extended);
+    REQUIRE(info[2] == 100 << 1);
+    REQUIRE(info[3] == (27 << 1 | 1));
+    REQUIRE(info[4] == 0x55);
+    const auto rr = FrameSerializer::serialize(Frame(Frame::Type::RR, false, 0x03, 127), ControlField::Extended);
+    REQUIRE(rr[2] == 0x01);
+    REQUIRE(rr[3] == 0xFE);
+
+    // U frames keep a one byte control field.
+    const Frame ua(Frame::Type::UA, true, 0x03);
+    REQUIRE(FrameSerializer::serialize(ua, ControlField::Extended) == FrameSerializer::serialize(ua));
+
+    // A frame too short for its control field is invalid.
+    const auto truncated = FrameSerializer::serialize(Frame(Frame::Type::RR, true, 0x03, 5));
+    const auto escaped   = FrameSerializer::escape(truncated);
+    REQUIRE(FrameSerializer::deserialize(truncated, ControlField::Extended).is_empty());
+    REQUIRE(FrameSerializer::decode(escaped, span<const uint8_t>(), ControlField::Extended).is_empty());
+  }
+
+  SECTION("Trailing escape does not leak")
+  {
+    const std::vector<uint8_t> truncated = {protocol_bytes::frame_boundary, 0x01, protocol_bytes::escape};
+    const std::vector<uint8_t> clean     = {0x01, 0x02, 0x03};
+    REQUIRE(FrameSerializer::descape(truncated) == std::vector<uint8_t>({protocol_bytes::frame_boundary, 0x01}));
+    REQUIRE(FrameSerializer::descape(clean) == clean);
+  }
+}
+
+TEST_CASE("Frame View")
+{
+  SECTION("Parse in place")
+  {
+    for (auto runs = 0; runs < TEST_REPEAT_HIGH; ++runs)
+    {
+      const auto frame = RandomFrameFactory::make();
+      const auto raw   = FrameSerializer::serialize(frame);
+      const auto view  = FrameSerializer::parse(raw);
+      REQUIRE(view == FrameView(frame));
+      REQUIRE(view.get_address() == frame.get_address());
+      REQUIRE(Frame(view) == frame);
+      if (view.has_payload())
+      {
+        REQUIRE(view.begin() == raw.data() + 3);
+      }
+    }
+  }
+
+  SECTION("Decode in place")
+  {
+    for (auto runs = 0; runs < TEST_REPEAT_HIGH; ++runs)
+    {
+      const auto frame   = RandomFrameFactory::make();
+      auto       escaped = FrameSerializer::escape(FrameSerializer::serialize(frame));
+      const auto before  = l_allocations.load();
+      const auto view    = FrameSerializer::decode_view(escaped);
+      const auto after   = l_allocations.load();
+      REQUIRE(before == after);
+      REQUIRE(Frame(view) == frame);
+      REQUIRE(view.end() <= escaped.data() + escaped.size());
+
+      auto escaped32 = FrameSerializer32::escape(FrameSerializer32::serialize(frame));
+      REQUIRE(Frame(FrameSerializer32::decode_view(escaped32)) == frame);
+    }
+  }
+
+  SECTION("Decode across a split")
+  {
+    std::array<uint8_t, 1200> storage;
+    for (auto runs = 0; runs < TEST_REPEAT_HIGH; ++runs)
+    {
+      const auto          frame   = RandomFrameFactory::make();
+      const auto          escaped = FrameSerializer::escape(FrameSerializer::serialize(frame));
+      const auto          split   = RandomFrameFactory::get_random(0, escaped.size());
+      span<const uint8_t> all(escaped);
+      const auto          view = FrameSerializer::decode_view(all.first(split), all.subspan(split), storage);
+      REQUIRE(Frame(view) == frame);
+    }
+  }
+
+  SECTION("Invalid frames")
+  {
+    const auto frame   = Frame(std::vector<uint8_t>({1, 2, 3, 4}), Frame::Type::I);
+    const auto escaped = FrameSerializer::escape(FrameSerializer::serialize(frame));
+
+    auto corrupted = escaped;
+    corrupted[4] ^= 0x01;
+    REQUIRE(FrameSerializer::decode_view(corrupted).is_empty());
+
+    auto aborted = escaped;
+    aborted.insert(aborted.end() - 1, protocol_bytes::escape);
+    REQUIRE(FrameSerializer::decode_view(aborted).is_empty());
+
+    std::array<uint8_t, 4> small;
+    REQUIRE(FrameSerializer::decode_view(escaped, span<const uint8_t>(), small).is_empty());
+    REQUIRE(FrameSerializer::parse(span<const uint8_t>(escaped).first(5)).is_empty());
+  }
+}
+
+TEST_CASE("Concurrent serializer use")
+{
+  // The random frame factory shares one generator so the frames are made up
+  // front and only the codec runs on the worker threads.
+  std::vector<Frame> frames;
+  for (auto runs = 0; runs < TEST_REPEAT_HIGH; ++runs)
+  {
+    frames.emplace_back(RandomFrameFactory::make());
+  }
+
+  const auto          thread_count = std::max(4u, std::thread::hardware_concurrency());
+  std::atomic<size_t> failures(0);
+  std::vector<std::thread> workers;
+
+  for (unsigned t = 0; t < thread_count; ++t)
+  {
+    workers.emplace_back([&, t] {
+      std::array<uint8_t, 2048> buffer;
+      for (auto runs = 0; runs < TEST_REPEAT_LOW; ++runs)
+      {
+        // Each thread walks the frames from a different offset so the threads
+        // are working on different frames at any one time.
+        for (size_t i = 0; i < frames.size(); ++i)
+        {
+          const auto& frame   = frames[(i + t * 97) % frames.size()];
+          const auto  escaped = FrameSerializer::escape(FrameSerializer::serialize(frame));
+          const auto  size    = FrameSerializer::encode(frame, buffer);
+
+          if (frame != FrameSerializer::deserialize(FrameSerializer::descape(escaped)))
+            ++failures;
+          if (size != escaped.size() || !std::equal(escaped.begin(), escaped.end(), buffer.begin()))
+            ++failures;
+          if (frame != FrameSerializer::decode(span<const uint8_t>(buffer.data(), size)))
+            ++failures;
+
+          const auto escaped32 = FrameSerializer32::escape(FrameSerializer32::serialize(frame));
+          if (frame != FrameSerializer32::decode(escaped32))
+            ++failures;
+        }
+      }
+    });
+  }
+
+  for (auto& worker : workers)
+  {
+    worker.join();
+  }
+
+  REQUIRE(failures == 0);
+}
+
+TEST_CASE("CRC")
+{
+  SECTION("Check value")
+  {
+    const std::string check = "123456789";
+    const auto        data  = reinterpret_cast<const uint8_t*>(check.data());
+    REQUIRE(crc::ccitt16::compute(data, data + check.size()) == 0x29B1);
+  }
+
+  SECTION("Matches boost crc_basic")
+  {
+    // The FCS has always been computed with this boost configuration, the
+    // table engine must produce identical results for every length.
+    boost::crc_basic<16> reference(0x1021, 0xFFFF, 0, false, false);
+    for (size_t length = 0; length < 600; ++length)
+    {
+      std::vector<uint8_t> buffer(length);
+      std::generate(buffer.begin(), buffer.end(), [] { return RandomFrameFactory::get_random_byte(); });
+      reference.reset();
+      reference.process_bytes(buffer.data(), buffer.size());
+      const auto begin = buffer.data();
+      const auto end   = buffer.data() + buffer.size();
+      REQUIRE(crc::ccitt16::compute(begin, end) == reference.checksum());
+      REQUIRE(crc::ccitt16::update_bytewise(crc::ccitt16::initial, begin, end) == reference.checksum());
+    }
+  }
+
+  SECTION("CRC-32 check value")
+  {
+    const std::string check = "123456789";
+    const auto        data  = reinterpret_cast<const uint8_t*>(check.data());
+    REQUIRE(crc::crc32::compute(data, data + check.size()) == 0xCBF43926);
+  }
+
+  SECTION("Dispatched kernel matches scalar path")
+  {
+    l_log->info("CRC kernel: {}", crc::active_kernel() == crc::kernel::clmul ? "clmul" : "table");
+
+    // Every length up to 4KiB so each folding tail and remainder is covered.
+    std::vector<uint8_t> buffer(4096);
+    std::generate(buffer.begin(), buffer.end(), [] { return RandomFrameFactory::get_random_byte(); });
+    for (size_t length = 0; length <= buffer.size(); ++length)
+    {
+      const auto begin = buffer.data();
+      const auto end   = buffer.data() + length;
+      const auto seed  = static_cast<uint16_t>(length * 0x9E37);
+
+      REQUIRE(crc::ccitt16::update(seed, begin, end) == crc::ccitt16::update_bytewise(seed, begin, end));
+      REQUIRE(crc::crc32::update(seed, begin, end) == crc::crc32::update_bytewise(seed, begin, end));
+      REQUIRE(crc::ccitt16::update_table(seed, begin, end) == crc::ccitt16::update_bytewise(seed, begin, end));
+      REQUIRE(crc::crc32::update_table(seed, begin, end) == crc::crc32::update_bytewise(seed, begin, end));
+#if HDLC_USE_CLMUL
+      if (crc::detail::clmul_supported())
+      {
+        REQUIRE(crc::detail::ccitt16_clmul(seed, begin, end) == crc::ccitt16::update_table(seed, begin, end));
+        REQUIRE(crc::detail::crc32_clmul(seed, begin, end) == crc::crc32::update_table(seed, begin, end));
+      }
+#endif
+    }
+  }
+}
+
+TEST_CASE("Byte stuffing")
+{
+  // Buffers where roughly one in `density` bytes is a flag or an escape.
+  const auto make_buffer = [](const size_t size, const size_t density) {
+    std::vector<uint8_t> buffer(size);
+    std::generate(buffer.begin(), buffer.end(), [&] {
+      if (RandomFrameFactory::get_random(1, density) == 1)
+        return (RandomFrameFactory::get_random_byte() & 1) ? uint8_t(protocol_bytes::frame_boundary) : uint8_t(protocol_bytes::escape);
+      return static_cast<uint8_t>(RandomFrameFactory::get_random_byte() & 0x7B);
+    });
+    return buffer;
+  };
+
+  SECTION("Vector kernels match scalar path")
+  {
+    const auto kind = stuffing::active_kernel();
+    l_log->info("Stuffing kernel: {}", kind == stuffing::kernel::avx2 ? "avx2" : kind == stuffing::kernel::sse2 ? "sse2" : "scalar");
+
+    for (const size_t density : {2, 64, 1000000})
+    {
+      const auto buffer = make_buffer(600, density);
+      for (size_t offset = 0; offset < 33; ++offset)
+      {
+        for (size_t length = 0; length + offset <= buffer.size(); length += 7)
+        {
+          const auto begin = buffer.data() + offset;
+          const auto end   = begin + length;
+
+          REQUIRE(stuffing::find_special(begin, end) == stuffing::find_special_scalar(begin, end));
+          REQUIRE(stuffing::count_special(begin, end) == stuffing::count_special_scalar(begin, end));
+          REQUIRE(stuffing::find_escape(begin, end) == stuffing::find_escape_scalar(begin, end));
+          REQUIRE(stuffing::find_flag(begin, end) == stuffing::find_flag_scalar(begin, end));
+#if HDLC_USE_X86_SIMD
+          REQUIRE(stuffing::detail::find_special_sse2(begin, end) == stuffing::find_special_scalar(begin, end));
+          REQUIRE(stuffing::detail::count_special_sse2(begin, end) == stuffing::count_special_scalar(begin, end));
+          REQUIRE(stuffing::detail::find_escape_sse2(begin, end) == stuffing::find_escape_scalar(begin, end));
+          REQUIRE(stuffing::detail::find_flag_sse2(begin, end) == stuffing::find_flag_scalar(begin, end));
+          if (stuffing::detail::avx2_supported())
+          {
+            REQUIRE(stuffing::detail::find_special_avx2(begin, end) == stuffing::find_special_scalar(begin, end));
+            REQUIRE(stuffing::detail::count_special_avx2(begin, end) == stuffing::count_special_scalar(begin, end));
+            REQUIRE(stuffing::detail::find_escape_avx2(begin, end) == stuffing::find_escape_scalar(begin, end));
+            REQUIRE(stuffing::detail::find_flag_avx2(begin, end) == stuffing::find_flag_scalar(begin, end));
+          }
+#endif
+        }
+      }
+    }
+  }
+
+  SECTION("Single special byte at every position")
+  {
+    std::vector<uint8_t> buffer(100, 0x55);
+    for (size_t i = 0; i < buffer.size(); ++i)
+    {
+      buffer[i]        = protocol_bytes::escape;
+      const auto begin = buffer.data();
+      const auto end   = buffer.data() + buffer.size();
+      REQUIRE(stuffing::find_special(begin, end) == begin + i);
+      REQUIRE(stuffing::find_escape(begin, end) == begin + i);
+      REQUIRE(stuffing::count_special(begin, end) == 1);
+      buffer[i] = 0x55;
+    }
+  }
+
+  SECTION("Escape & unescape roundtrip")
+  {
+    for (const size_t density : {2, 100, 1000000})
+    {
+      for (auto runs = 0; runs < TEST_REPEAT_LOW; ++runs)
+      {
+        const auto buffer = make_buffer(RandomFrameFactory::get_random(0, 2048), density);
+        const auto begin  = buffer.data();
+        const auto end    = buffer.data() + buffer.size();
+
+        std::vector<uint8_t> escaped(buffer.size() + stuffing::count_special(begin, end));
+        REQUIRE(stuffing::escape(begin, end, escaped.data()) == escaped.data() + escaped.size());
+        REQUIRE(stuffing::count_special(escaped.data(), escaped.data() + escaped.size()) == escaped.size() - buffer.size());
+        REQUIRE(std::count(escaped.begin(), escaped.end(), protocol_bytes::frame_boundary) == 0);
+
+        // Unescape in two blocks split at every point of interest, including
+        // between an escape and the byte it applies to.
+        const auto split = RandomFrameFactory::get_random(0, escaped.size());
+        std::vector<uint8_t> unescaped(escaped.size());
+        bool                 pending = false;
+        auto                 out     = stuffing::unescape(escaped.data(), escaped.data() + split, unescaped.data(), pending);
+        out                          = stuffing::unescape(escaped.data() + split, escaped.data() + escaped.size(), out, pending);
+        REQUIRE_FALSE(pending);
+        unescaped.resize(out - unescaped.data());
+        REQUIRE(unescaped == buffer);
+      }
+    }
+  }
 }
 
 TEST_CASE("Frame Pipe Test")
@@ -196,6 +877,54 @@ TEST_CASE("Frame Pipe Test")
     REQUIRE(pipe1.frame_count() == 0);
   }
 
+  SECTION("Idle boundaries are skipped.")
+  {
+    pipe1.write(protocol_bytes::frame_boundary);
+    pipe1.write(protocol_bytes::frame_boundary);
+    pipe1.write(test_data1);
+    REQUIRE(pipe1.frame_count() == 2);
+    const auto data_out = pipe1.read_frame();
+    REQUIRE(data_out == test_data1);
+    REQUIRE(pipe1.empty() == true);
+  }
+
+  SECTION("Frame writes wrap around.")
+  {
+    FramePipe  pipe(64);
+    const auto frame    = Frame(std::vector<uint8_t>({1, 2, 0x7e, 3}), Frame::Type::I);
+    const auto expected = FrameSerializer::escape(FrameSerializer::serialize(frame));
+    const auto encoder  = [&](span<uint8_t> first, span<uint8_t> second) { return FrameSerializer::encode(frame, first, second); };
+
+    for (auto i = TEST_REPEAT_HIGH; i--;)
+    {
+      REQUIRE(pipe.write_frame(encoder));
+      REQUIRE(pipe.frame_count() == 1);
+      REQUIRE(pipe.read_frame() == expected);
+      REQUIRE(pipe.empty());
+
+      Frame decoded;
+      REQUIRE(pipe.write_frame(encoder));
+      REQUIRE(pipe.read_frame([&](span<const uint8_t> first, span<const uint8_t> second) {
+        decoded = FrameSerializer::decode(first, second);
+      }));
+      REQUIRE(decoded == frame);
+      REQUIRE(pipe.empty());
+      pipe.write(0); // Offset the head so frames land on every wrap point.
+      pipe.read();
+    }
+  }
+
+  SECTION("Frame writes fail cleanly.")
+  {
+    FramePipe  pipe(16);
+    const auto frame = Frame(std::vector<uint8_t>(32, 0x55), Frame::Type::I);
+    pipe.write(1);
+    REQUIRE(pipe.write_frame([&](span<uint8_t> first, span<uint8_t> second) { return FrameSerializer::encode(frame, first, second); }) ==
+            false);
+    REQUIRE(pipe.size() == 1);
+    REQUIRE(pipe.boundary_count() == 0);
+  }
+
   SECTION("Array writes - multiple frames.")
   {
     for (auto i = TEST_REPEAT_LOW; i--;) pipe1.write(test_data1);
@@ -209,23 +938,1969 @@ TEST_CASE("Frame Pipe Test")
       REQUIRE(pipe1.frame_count() == i);
     }
   }
-}
 
-TEST_CASE("Frame Loopback")
-{
-  loopback_io io; // create io port.
-
-  SECTION("Single frame - Small size.")
+  SECTION("Deep buffer of small frames.")
   {
-    for (auto i = TEST_REPEAT_LOW; i--;)
+    // Many frames queued at once with idle flags and line noise between
+    // them, written in odd sized chunks so boundaries land on every wrap point.
+    FramePipe            pipe(4096);
+    std::vector<Frame>   sent;
+    std::vector<uint8_t> stream;
+    for (auto i = 0; i < 200; ++i)
     {
-      auto  f1 = RandomFrameFactory::make_inforamtion(io.max_send_size() >> 1);
-      Frame f2;
-      l_log->info("{}", f1);
+      sent.emplace_back(RandomFrameFactory::make_inforamtion(8));
+      const auto bytes = FrameSerializer::escape(FrameSerializer::serialize(sent.back()));
+      stream.insert(stream.end(), bytes.begin(), bytes.end());
+      if (i % 3 == 0)
+        stream.insert(stream.end(), {protocol_bytes::frame_boundary, protocol_bytes::frame_boundary});
+      if (i % 7 == 0)
+        stream.insert(stream.end(), {0x01, 0x02});
+    }
 
-      REQUIRE(io.send_frame(f1));
-      REQUIRE(io.recieve_frame(f2));
-      REQUIRE(f1 == f2);
+    for (auto runs = 0; runs < TEST_REPEAT_LOW; ++runs)
+    {
+      size_t written = 0, received = 0;
+      while (received < sent.size())
+      {
+        const auto chunk = std::min<size_t>(stream.size() - written, RandomFrameFactory::get_random(1, 300));
+        if (chunk && pipe.space() >= chunk)
+        {
+          pipe.write(stream.begin() + written, stream.begin() + written + chunk);
+          written += chunk;
+        }
+
+        // Drain a random number of frames so the queue depth varies.
+        for (auto drain = RandomFrameFactory::get_random(0, 8); drain-- && pipe.frame_count();)
+        {
+          Frame decoded;
+          if (pipe.read_frame([&](span<const uint8_t> first, span<const uint8_t> second) { decoded = FrameSerializer::decode(first, second); }))
+          {
+            REQUIRE(received < sent.size());
+            REQUIRE(decoded == sent[received++]);
+          }
+        }
+      }
+      REQUIRE(written == stream.size());
+      REQUIRE(pipe.frame_count() == 0);
+      pipe.clear();
+    }
+  }
+
+  SECTION("Byte reads keep the boundary index.")
+  {
+    const std::vector<uint8_t> junk = {0x01, protocol_bytes::frame_boundary, 0x02};
+    pipe1.write(junk);
+    pipe1.write(test_data1);
+    REQUIRE(pipe1.boundary_count() == 3);
+    REQUIRE(pipe1.read() == 0x01);
+    REQUIRE(pipe1.partial_frame());
+    REQUIRE(pipe1.read() == protocol_bytes::frame_boundary);
+    REQUIRE(pipe1.boundary_count() == 2);
+    REQUIRE(pipe1.read_frame() == test_data1);
+    REQUIRE(pipe1.empty());
+  }
+
+  SECTION("Span writes are partial.")
+  {
+    // Move the ring so the free space wraps.
+    const std::vector<uint8_t> filler(1000, 0x55);
+    pipe1.write(filler);
+    std::vector<uint8_t> out(1000);
+    REQUIRE(pipe1.read(span<uint8_t>(out)) == 1000);
+
+    std::vector<uint8_t> data(1100);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i);
+    std::copy(test_data1.begin(), test_data1.end(), data.begin() + 10);
+
+    REQUIRE(pipe1.write(span<const uint8_t>(data)) == 1024);
+    REQUIRE(pipe1.full());
+    REQUIRE(pipe1.write(span<const uint8_t>(data)) == 0);
+    REQUIRE(pipe1.boundary_count() >= 2);
+
+    const auto regions = pipe1.readable_regions();
+    REQUIRE(regions.first.size() == 24);
+    REQUIRE(regions.second.size() == 1000);
+
+    out.resize(1024);
+    REQUIRE(pipe1.read(span<uint8_t>(out)) == 1024);
+    REQUIRE(std::equal(out.begin(), out.end(), data.begin()));
+    REQUIRE(pipe1.empty());
+    REQUIRE(pipe1.boundary_count() == 0);
+  }
+}
+
+TEST_CASE("Frame Pipe Threads")
+{
+  // One producer and one consumer thread, the case both pipe types support.
+  // Frames are written in chunks and single bytes and must come out whole and
+  // in order.
+  std::vector<Frame>   sent;
+  std::vector<uint8_t> stream;
+  for (auto i = 0; i < TEST_REPEAT_HIGH; ++i)
+  {
+    sent.emplace_back(RandomFrameFactory::make_inforamtion(64));
+    const auto bytes = FrameSerializer::escape(FrameSerializer::serialize(sent.back()));
+    stream.insert(stream.end(), bytes.begin(), bytes.end());
+  }
+
+  const auto run = [&](auto& pipe) {
+    std::thread producer([&] {
+      size_t written = 0;
+      while (written < stream.size())
+      {
+        const auto chunk = std::min<size_t>(stream.size() - written, 1 + (written % 97));
+        if (chunk == 1 || (written & 1))
+        {
+          if (pipe.full())
+          {
+            std::this_thread::yield();
+            continue;
+          }
+          pipe.write(stream[written++]);
+        }
+        else if (pipe.space() >= chunk)
+        {
+          pipe.write(stream.begin() + written, stream.begin() + written + chunk);
+          written += chunk;
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    size_t received = 0, mismatches = 0;
+    while (received < sent.size())
+    {
+      Frame decoded;
+      if (pipe.read_frame([&](span<const uint8_t> first, span<const uint8_t> second) { decoded = FrameSerializer::decode(first, second); }))
+      {
+        mismatches += (decoded == sent[received++]) ? 0 : 1;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+
+    producer.join();
+    REQUIRE(mismatches == 0);
+    REQUIRE(pipe.empty());
+    REQUIRE(pipe.boundary_count() == 0);
+  };
+
+  SECTION("Mutex pipe")
+  {
+    FramePipe pipe(256);
+    run(pipe);
+  }
+
+  SECTION("Lock free pipe")
+  {
+    SpscFramePipe pipe(256);
+    run(pipe);
+  }
+
+#if HDLC_USE_MIRRORED_RING
+  SECTION("Mirrored lock free pipe")
+  {
+    SpscMirroredFramePipe pipe(256);
+    run(pipe);
+  }
+#endif
+}
+
+#if HDLC_USE_MIRRORED_RING
+TEST_CASE("Mirrored Frame Pipe")
+{
+  MirroredFramePipe pipe(100);
+  const auto        capacity = pipe.capacity();
+  REQUIRE(capacity == mirrored_ring::page_size());
+  REQUIRE(pipe.contiguous());
+  REQUIRE(pipe.storage().size() == 2 * capacity);
+
+  // Leaves the head and tail offset bytes before the end of the storage.
+  size_t     position = 0;
+  const auto move_to  = [&](const size_t offset) {
+    const std::vector<uint8_t> filler((2 * capacity - offset - position % capacity) % capacity, 0x55);
+    std::vector<uint8_t>       out(filler.size());
+    pipe.write(filler);
+    REQUIRE(pipe.read(span<uint8_t>(out)) == out.size());
+    REQUIRE(pipe.empty());
+    position += filler.size();
+  };
+
+  const auto frame = RandomFrameFactory::make_inforamtion(64);
+  const auto bytes = FrameSerializer::escape(FrameSerializer::serialize(frame));
+
+  SECTION("Both copies are the same memory.")
+  {
+    auto storage = pipe.storage();
+    storage[10]  = 0xA5;
+    REQUIRE(storage[capacity + 10] == 0xA5);
+    storage[capacity + 20] = 0x5A;
+    REQUIRE(storage[20] == 0x5A);
+  }
+
+  SECTION("Frames across the wrap are contiguous.")
+  {
+    for (size_t offset = 1; offset < bytes.size(); ++offset)
+    {
+      move_to(offset);
+      pipe.write(bytes);
+      REQUIRE(pipe.frame_count() == 1);
+
+      bool contiguous = false;
+      bool straddles  = false;
+      REQUIRE(pipe.read_frame([&](span<const uint8_t> first, span<const uint8_t> second) {
+        contiguous = second.empty() && first.size() == bytes.size() && std::equal(first.begin(), first.end(), bytes.begin());
+        straddles  = first.end() > pipe.storage().begin() + capacity;
+        REQUIRE(FrameSerializer::decode(first, second) == frame);
+      }));
+      REQUIRE(contiguous);
+      REQUIRE(straddles);
+      REQUIRE(pipe.empty());
+      position += bytes.size();
+    }
+  }
+
+  SECTION("Regions across the wrap are contiguous.")
+  {
+    move_to(7);
+    const auto space = pipe.writable_regions();
+    REQUIRE(space.second.empty());
+    REQUIRE(space.first.size() == capacity);
+    std::copy(bytes.begin(), bytes.end(), space.first.begin());
+    pipe.commit(bytes.size());
+    REQUIRE(pipe.frame_count() == 1);
+
+    const auto data = pipe.readable_regions();
+    REQUIRE(data.second.empty());
+    REQUIRE(data.first.size() == bytes.size());
+    REQUIRE(std::equal(data.first.begin(), data.first.end(), bytes.begin()));
+    REQUIRE(pipe.read_frame() == bytes);
+  }
+
+  SECTION("Same frames as a heap ring.")
+  {
+    FramePipe            reference(capacity);
+    std::vector<uint8_t> stream;
+    for (auto i = 0; i < TEST_REPEAT_HIGH; ++i)
+    {
+      const auto next = FrameSerializer::escape(FrameSerializer::serialize(RandomFrameFactory::make_inforamtion(200)));
+      pipe.write(next);
+      reference.write(next);
+      REQUIRE(pipe.read_frame() == reference.read_frame());
+    }
+    REQUIRE(pipe.empty());
+  }
+
+  SECTION("Basic io.")
+  {
+    basic_loopback_io<fcs16, MirroredFramePipe> io;
+    for (auto i = TEST_REPEAT_LOW * 20; i--;)
+    {
+      const auto f1 = RandomFrameFactory::make_inforamtion(io.max_send_size() >> 2);
+      Frame      f2;
+      REQUIRE(io.send_frame(f1));
+      REQUIRE(io.recieve_frame(f2));
+      REQUIRE(f1 == f2);
+    }
+  }
+}
+#endif
+
+TEST_CASE("Frame Pipe Wait")
+{
+  using clock = std::chrono::steady_clock;
+
+  const auto frame = FrameSerializer::escape(FrameSerializer::serialize(Frame(Frame::Type::RR, true, 0x10, 3)));
+
+  auto run = [&frame](auto& pipe) {
+    // Times out on an idle pipe.
+    auto start = clock::now();
+    REQUIRE(pipe.wait_for_frame(20) == false);
+    REQUIRE(clock::now() - start >= std::chrono::milliseconds(20));
+
+    // Returns straight away when a frame is queued.
+    pipe.write(frame);
+    REQUIRE(pipe.wait_for_frame(1000));
+    pipe.read_frame();
+
+    // Wakes as soon as another thread completes a frame, byte by byte.
+    std::thread producer([&] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      for (const auto byte : frame)
+      {
+        pipe.write(byte);
+      }
+    });
+
+    start                = clock::now();
+    const auto cpu_start = std::clock();
+    REQUIRE(pipe.wait_for_frame(5000));
+    const auto cpu     = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    const auto elapsed = clock::now() - start;
+    producer.join();
+
+    REQUIRE(pipe.frame_count() == 1);
+    REQUIRE(elapsed < std::chrono::milliseconds(1000));
+    // Asleep rather than spinning while the producer sleeps.
+    REQUIRE(cpu < 0.010);
+  };
+
+  SECTION("Mutex pipe")
+  {
+    FramePipe pipe(256);
+    run(pipe);
+  }
+
+  SECTION("Lock free pipe")
+  {
+    SpscFramePipe pipe(256);
+    run(pipe);
+  }
+}
+
+TEST_CASE("Frame Loopback")
+{
+  loopback_io io; // create io port.
+
+  SECTION("Single frame - Small size.")
+  {
+    for (auto i = TEST_REPEAT_LOW; i--;)
+    {
+      auto  f1 = RandomFrameFactory::make_inforamtion(io.max_send_size() >> 1);
+      Frame f2;
+      l_log->info("{}", f1);
+
+      REQUIRE(io.send_frame(f1));
+      REQUIRE(io.recieve_frame(f2));
+      REQUIRE(f1 == f2);
+    }
+  }
+
+  SECTION("Sending does not allocate.")
+  {
+    const auto f1     = RandomFrameFactory::make_inforamtion(io.max_send_size() >> 2);
+    const auto before = l_allocations.load();
+    const auto sent   = io.send_frame(f1);
+    const auto after  = l_allocations.load();
+    REQUIRE(sent);
+    REQUIRE(before == after);
+
+    Frame f2;
+    REQUIRE(io.recieve_frame(f2));
+    REQUIRE(f1 == f2);
+  }
+
+  SECTION("Single frame - view.")
+  {
+    std::vector<uint8_t> storage(io.max_recieve_size());
+    for (auto i = TEST_REPEAT_LOW; i--;)
+    {
+      const auto f1 = RandomFrameFactory::make_inforamtion(io.max_send_size() >> 1);
+      FrameView  view;
+
+      REQUIRE(io.send_frame(f1));
+      REQUIRE(io.recieve_frame(view, storage));
+      REQUIRE(view == FrameView(f1));
+      REQUIRE(view.begin() >= storage.data());
+      REQUIRE(view.end() <= storage.data() + storage.size());
+    }
+  }
+
+  SECTION("Single frame - gathered payload.")
+  {
+    const std::vector<uint8_t>               head    = {0x7e, 1, 2, 3};
+    const std::vector<uint8_t>               body(200, 0x55);
+    const std::array<span<const uint8_t>, 2> payload = {{head, body}};
+    const FrameView                          header(Frame::Type::I, true, 0x11, 2, 5);
+
+    REQUIRE(io.send_frame(header, payload));
+    Frame f2;
+    REQUIRE(io.recieve_frame(f2));
+
+    std::vector<uint8_t> joined(head);
+    joined.insert(joined.end(), body.begin(), body.end());
+    REQUIRE(f2 == Frame(joined, Frame::Type::I, true, 0x11, 2, 5));
+  }
+
+  SECTION("Master sends gathered payload.")
+  {
+    // The loopback answers every command with the command itself.
+    session::snrm::Master<loopback_io>       master(io);
+    const std::vector<uint8_t>               head(10, 0xAA);
+    const std::vector<uint8_t>               tail(100, 0xBB);
+    const std::array<span<const uint8_t>, 2> payload = {{head, tail}};
+
+    std::vector<uint8_t> response;
+    REQUIRE(master.send_payload_parts(payload, response) == StatusError::Success);
+    REQUIRE(response.size() == head.size() + tail.size());
+    REQUIRE(std::equal(head.begin(), head.end(), response.begin()));
+    REQUIRE(std::equal(tail.begin(), tail.end(), response.begin() + head.size()));
+  }
+
+  SECTION("Subscribed handler.")
+  {
+    std::mutex              mutex;
+    std::condition_variable cv;
+    std::vector<Frame>      received;
+
+    io.on_frame([&](const FrameView& view) {
+      std::lock_guard<std::mutex> lock(mutex);
+      received.emplace_back(view);
+      cv.notify_all();
+    });
+
+    std::vector<Frame> sent;
+    for (auto i = TEST_REPEAT_LOW; i--;)
+    {
+      sent.push_back(RandomFrameFactory::make_inforamtion(io.max_send_size() >> 3));
+      REQUIRE(io.send_frame(sent.back()));
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    REQUIRE(cv.wait_for(lock, std::chrono::seconds(1), [&] { return received.size() == sent.size(); }));
+    REQUIRE(std::equal(received.begin(), received.end(), sent.begin()));
+    REQUIRE(io.in_frame_count() == 0);
+  }
+
+  SECTION("Subscribed handler - executor.")
+  {
+    std::mutex                         mutex;
+    std::vector<std::function<void()>> tasks;
+    std::vector<Frame>                 received;
+
+    io.on_frame([&](const FrameView& view) { received.emplace_back(view); },
+                [&](std::function<void()> task) {
+                  std::lock_guard<std::mutex> lock(mutex);
+                  tasks.push_back(std::move(task));
+                });
+
+    const auto f1 = RandomFrameFactory::make_inforamtion(io.max_send_size() >> 1);
+    REQUIRE(io.send_frame(f1));
+
+    // The tasks run on this thread, the io thread only queues them.
+    const auto start = std::chrono::steady_clock::now();
+    while (received.empty() && std::chrono::steady_clock::now() - start < std::chrono::seconds(1))
+    {
+      std::vector<std::function<void()>> pending;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.swap(tasks);
+      }
+      for (auto& task : pending) task();
+      std::this_thread::yield();
+    }
+
+    REQUIRE(received.size() == 1);
+    REQUIRE(received.front() == f1);
+  }
+
+  SECTION("Single frame - 32 bit FCS.")
+  {
+    basic_loopback_io<fcs32> io32;
+    for (auto i = TEST_REPEAT_LOW; i--;)
+    {
+      auto  f1 = RandomFrameFactory::make_inforamtion(io32.max_send_size() >> 1);
+      Frame f2;
+
+      REQUIRE(io32.send_frame(f1));
+      REQUIRE(io32.recieve_frame(f2));
+      REQUIRE(f1 == f2);
+    }
+  }
+  SECTION("Single frame - lock free pipes.")
+  {
+    spsc_loopback_io spsc_io;
+    for (auto i = TEST_REPEAT_LOW; i--;)
+    {
+      auto  f1 = RandomFrameFactory::make_inforamtion(spsc_io.max_send_size() >> 1);
+      Frame f2;
+
+      REQUIRE(spsc_io.send_frame(f1));
+      REQUIRE(spsc_io.recieve_frame(f2));
+      REQUIRE(f1 == f2);
+    }
+  }
+}
+
+TEST_CASE("Bulk byte transfer")
+{
+  // Bytes are moved by hand, as a transport would.
+  struct manual_io : public base_io
+  {
+    size_t get_tick(void) const override { return 0; }
+    bool   handle_out(void) override { return true; }
+    bool   handle_in(void) override { return true; }
+    void   reset(void) override {}
+    void   sleep(const size_t) override {}
+  };
+
+  manual_io  a, b;
+  const auto f1 = RandomFrameFactory::make_inforamtion(a.max_send_size() >> 2);
+
+  SECTION("Spans.")
+  {
+    std::array<uint8_t, 512> wire;
+    for (auto i = TEST_REPEAT_LOW; i--;)
+    {
+      Frame rx;
+      REQUIRE(a.send_frame(f1));
+      const auto count = a.out_bytes(span<uint8_t>(wire.data(), wire.size()));
+      REQUIRE(count > 0);
+      REQUIRE(a.out_bytes(span<uint8_t>(wire.data(), wire.size())) == 0);
+      REQUIRE(b.in_bytes(span<const uint8_t>(wire.data(), count)) == count);
+      REQUIRE(b.in_frame_count() == 1);
+      REQUIRE(b.recieve_frame(rx));
+      REQUIRE(rx == f1);
+    }
+  }
+
+  SECTION("Small chunks.")
+  {
+    std::array<uint8_t, 7> wire;
+    std::vector<Frame>     received;
+    b.on_frame([&received](const FrameView& view) { received.emplace_back(view); });
+
+    REQUIRE(a.send_frame(f1));
+    REQUIRE(a.send_frame(f1));
+    for (;;)
+    {
+      const auto end = a.out_bytes(wire.begin(), wire.end());
+      if (end == wire.begin())
+        break;
+      REQUIRE(b.in_bytes(span<const uint8_t>(wire.data(), end - wire.begin())) == size_t(end - wire.begin()));
+    }
+    REQUIRE(received.size() == 2);
+    REQUIRE(received[0] == f1);
+    REQUIRE(received[1] == f1);
+  }
+
+  SECTION("Full in pipe.")
+  {
+    const std::vector<uint8_t> wire(b.max_recieve_size() + 10, 0x55);
+    REQUIRE(b.in_bytes(span<const uint8_t>(wire)) == b.max_recieve_size());
+    REQUIRE(b.in_bytes(span<const uint8_t>(wire)) == 0);
+  }
+}
+
+namespace
+{
+/**
+ * @brief      A master and a client joined by a link_io, the client runs on
+ *             its own thread and keeps every payload it is handed.
+ */
+struct snrm_link
+{
+  using master_type = session::snrm::Master<link_io::endpoint>;
+  using client_type = session::snrm::Client<link_io::endpoint>;
+  using drop_type   = std::function<bool(const Frame&)>;
+
+  snrm_link() : master(link.a, 0x01, 0x02), client(link.b, 0x02, 0x01)
+  {
+    client.install_handler(Frame::Type::I, [this](client_type&, const Frame& cmd, Frame& resp) {
+      if (consumer)
+      {
+        const auto ret = consumer(cmd);
+        if (ret != StatusError::Success)
+          return ret;
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      received.emplace_back(cmd.begin(), cmd.end());
+      if (echo)
+        resp = Frame(cmd.get_payload(), Frame::Type::I);
+      return StatusError::Success;
+    });
+
+    link.set_tamper(
+        [this](std::vector<uint8_t>& bytes) {
+          const auto frame = FrameSerializer::decode(span<const uint8_t>(bytes), span<const uint8_t>(), link.a.control_field());
+          information += frame.is_information();
+          return !(drop_command && drop_command(frame));
+        },
+        [this](std::vector<uint8_t>& bytes) {
+          const auto frame = FrameSerializer::decode(span<const uint8_t>(bytes), span<const uint8_t>(), link.b.control_field());
+          ++responses;
+          selective += frame.get_type() == Frame::Type::SREJ;
+          not_ready += frame.get_type() == Frame::Type::RNR;
+          return !(drop_response && drop_response(frame));
+        });
+
+    t_client = std::thread([this] {
+      while (!done) client.run();
+    });
+  }
+
+  ~snrm_link()
+  {
+    // Wake the client with a frame for nobody.
+    done            = true;
+    const auto wake = FrameSerializer::escape(FrameSerializer::serialize(Frame(Frame::Type::UI, false, 0x7F)));
+    link.b.in_bytes(span<const uint8_t>(wake));
+    t_client.join();
+  }
+
+  std::vector<std::vector<uint8_t>> payloads(void)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return received;
+  }
+
+  /**
+   * @brief      Drops the nth frame matching, once.
+   */
+  static drop_type drop_nth(const size_t n, std::function<bool(const Frame&)> match)
+  {
+    auto seen = std::make_shared<size_t>(0);
+    return [=](const Frame& frame) { return match(frame) && (*seen)++ == n; };
+  }
+
+  link_io                           link;
+  master_type                       master;
+  client_type                       client;
+  std::mutex                        mutex;
+  std::vector<std::vector<uint8_t>> received;
+  bool                              echo = false;
+  std::atomic<size_t>               information{0}; //! Information frames sent by the master.
+  std::atomic<size_t>               responses{0};   //! Frames sent by the client.
+  std::atomic<size_t>               selective{0};   //! SREJ frames sent by the client.
+  std::atomic<size_t>               not_ready{0};   //! RNR frames sent by the client.
+  drop_type                         drop_command;   //! Set before connecting.
+  drop_type                         drop_response;  //! Set before connecting.
+  std::function<StatusError(const Frame&)> consumer; //! Set before connecting, runs first in the handler.
+  std::atomic<bool>                 done{false};
+  std::thread                       t_client;
+};
+
+std::vector<std::vector<uint8_t>> numbered_payloads(const size_t count)
+{
+  std::vector<std::vector<uint8_t>> payloads;
+  for (size_t i = 0; i < count; ++i) payloads.emplace_back(16, static_cast<uint8_t>(i));
+  return payloads;
+}
+
+/**
+ * @brief      Reaches the byte count the send window keeps per frame.
+ */
+struct window_probe : session::WindowedSession
+{
+  template <typename serializer_t>
+  static size_t frame_bytes(const std::vector<uint8_t>& payload)
+  {
+    sent_frame entry;
+    entry.frame = Frame(payload, Frame::Type::I, false, 0x02);
+    return WindowedSession::frame_bytes<serializer_t>(entry);
+  }
+};
+} // namespace
+
+TEST_CASE("Sliding window")
+{
+  snrm_link  s;
+  const auto sent = numbered_payloads(50);
+
+  SECTION("Window in flight.")
+  {
+    REQUIRE(s.master.connect() == StatusError::Success);
+    REQUIRE(s.master.window() == 7);
+    const auto before = s.responses.load();
+    for (const auto& payload : sent) REQUIRE(s.master.queue_payload(payload) == StatusError::Success);
+    REQUIRE(s.master.outstanding() <= 7);
+    REQUIRE(s.master.flush() == StatusError::Success);
+    REQUIRE(s.master.outstanding() == 0);
+    REQUIRE(s.payloads() == sent);
+    REQUIRE(s.information == sent.size());
+    // One response acknowledges several frames.
+    REQUIRE(s.responses - before < sent.size() / 2);
+  }
+
+  SECTION("Window of one is stop and wait.")
+  {
+    REQUIRE(s.master.connect() == StatusError::Success);
+    s.master.set_window(1);
+    const auto before = s.responses.load();
+    for (size_t i = 0; i < 10; ++i) REQUIRE(s.master.queue_payload(sent[i]) == StatusError::Success);
+    REQUIRE(s.master.flush() == StatusError::Success);
+    REQUIRE(s.responses - before == 10);
+    REQUIRE(s.payloads() == numbered_payloads(10));
+  }
+
+  SECTION("Rejected frames are repeated.")
+  {
+    s.drop_command = snrm_link::drop_nth(2, [](const Frame& f) { return f.is_information() && !f.is_poll(); });
+    REQUIRE(s.master.connect() == StatusError::Success);
+    for (const auto& payload : sent) REQUIRE(s.master.queue_payload(payload) == StatusError::Success);
+    REQUIRE(s.master.flush() == StatusError::Success);
+    REQUIRE(s.payloads() == sent);
+    REQUIRE(s.information > sent.size());
+  }
+
+  SECTION("Lost poll times out and is repeated.")
+  {
+    s.drop_command = snrm_link::drop_nth(0, [](const Frame& f) { return f.is_information() && f.is_poll(); });
+    REQUIRE(s.master.connect() == StatusError::Success);
+    for (size_t i = 0; i < 10; ++i) REQUIRE(s.master.queue_payload(sent[i]) == StatusError::Success);
+    REQUIRE(s.master.flush() == StatusError::Success);
+    REQUIRE(s.payloads() == numbered_payloads(10));
+  }
+
+  SECTION("Lost acknowledgement is recovered.")
+  {
+    s.drop_response = snrm_link::drop_nth(0, [](const Frame& f) { return f.get_type() == Frame::Type::RR; });
+    REQUIRE(s.master.connect() == StatusError::Success);
+    for (size_t i = 0; i < 10; ++i) REQUIRE(s.master.queue_payload(sent[i]) == StatusError::Success);
+    REQUIRE(s.master.flush() == StatusError::Success);
+    REQUIRE(s.payloads() == numbered_payloads(10));
+    // Nothing was lost, nothing is sent twice.
+    REQUIRE(s.information == 10);
+  }
+
+  SECTION("Stop and wait payloads.")
+  {
+    s.echo = true;
+    REQUIRE(s.master.connect() == StatusError::Success);
+    for (size_t i = 0; i < 10; ++i)
+    {
+      std::vector<uint8_t> response;
+      REQUIRE(s.master.send_payload(sent[i], response) == StatusError::Success);
+      REQUIRE(response == sent[i]);
+    }
+    REQUIRE(s.master.test() == StatusError::Success);
+  }
+
+  SECTION("Disconnected client.")
+  {
+    REQUIRE(s.master.queue_payload(sent[0]) == StatusError::ConnectionError);
+    REQUIRE(s.master.connected() == false);
+    REQUIRE(s.master.outstanding() == 0);
+  }
+}
+
+TEST_CASE("Selective reject")
+{
+  snrm_link  s;
+  const auto sent = numbered_payloads(50);
+  s.client.set_selective_reject(true);
+  s.master.set_window(4);
+
+  // Drops the information frames numbered in drops, counting only those
+  // sent without poll.
+  const auto drop_data = [](std::vector<size_t> drops) {
+    auto seen = std::make_shared<size_t>(0);
+    return [=](const Frame& f) {
+      if (!f.is_information() || f.is_poll())
+        return false;
+      return std::find(drops.begin(), drops.end(), (*seen)++) != drops.end();
+    };
+  };
+
+  SECTION("Only lost frames are repeated.")
+  {
+    s.drop_command = drop_data({2});
+    REQUIRE(s.master.connect() == StatusError::Success);
+    for (const auto& payload : sent) REQUIRE(s.master.queue_payload(payload) == StatusError::Success);
+    REQUIRE(s.master.flush() == StatusError::Success);
+    REQUIRE(s.payloads() == sent);
+    REQUIRE(s.selective == 1);
+    REQUIRE(s.information == sent.size() + 1);
+  }
+
+  SECTION("Several gaps.")
+  {
+    s.drop_command = drop_data({1, 3, 10, 11});
+    REQUIRE(s.master.connect() == StatusError::Success);
+    for (const auto& payload : sent) REQUIRE(s.master.queue_payload(payload) == StatusError::Success);
+    REQUIRE(s.master.flush() == StatusError::Success);
+    REQUIRE(s.payloads() == sent);
+    REQUIRE(s.information == sent.size() + 4);
+  }
+
+  SECTION("Lost repeat.")
+  {
+    // The original and the first repeat of N(S) 1.
+    auto drops     = std::make_shared<size_t>(0);
+    s.drop_command = [drops](const Frame& f) { return f.is_information() && f.get_send_sequence() == 1 && (*drops)++ < 2; };
+    s.link.a.set_response_timeout(100);
+    REQUIRE(s.master.connect() == StatusError::Success);
+    for (size_t i = 0; i < 4; ++i) REQUIRE(s.master.queue_payload(sent[i]) == StatusError::Success);
+    REQUIRE(s.master.flush() == StatusError::Success);
+    REQUIRE(s.payloads() == numbered_payloads(4));
+  }
+
+  SECTION("Lost poll.")
+  {
+    s.drop_command = snrm_link::drop_nth(0, [](const Frame& f) { return f.is_information() && f.is_poll(); });
+    s.link.a.set_response_timeout(100);
+    REQUIRE(s.master.connect() == StatusError::Success);
+    for (size_t i = 0; i < 10; ++i) REQUIRE(s.master.queue_payload(sent[i]) == StatusError::Success);
+    REQUIRE(s.master.flush() == StatusError::Success);
+    REQUIRE(s.payloads() == numbered_payloads(10));
+  }
+}
+
+TEST_CASE("Reorder buffer")
+{
+  using client_type = session::snrm::Client<link_io::endpoint>;
+
+  link_io          link;
+  client_type      client(link.b, 0x02, 0x01);
+  std::vector<int> delivered;
+  client.install_handler(Frame::Type::I, [&delivered](client_type&, const Frame& cmd, Frame&) {
+    delivered.push_back(cmd.get_send_sequence());
+    return StatusError::Success;
+  });
+  client.set_selective_reject(true);
+
+  Frame resp(Frame::Type::UNSET);
+  REQUIRE(client.handle(Frame(Frame::Type::SNRM, true, 0x02), resp) == StatusError::Success);
+  REQUIRE(resp.get_type() == Frame::Type::UA);
+
+  const auto information = [](const uint8_t ns, const bool poll) {
+    return Frame(std::vector<uint8_t>{ns}, Frame::Type::I, poll, 0x02, 0, ns);
+  };
+  const auto handle = [&](const Frame& cmd) {
+    Frame r(Frame::Type::UNSET);
+    REQUIRE(client.handle(cmd, r) == StatusError::Success);
+    return r;
+  };
+
+  // 0 and 2 are missing, 1 and 3 are held.
+  REQUIRE(handle(information(1, false)).is_valid() == false);
+  REQUIRE(handle(information(3, false)).is_valid() == false);
+  REQUIRE(delivered.empty());
+
+  // A poll is answered with SREJ for each gap and RR with V(R).
+  const auto status = handle(Frame(Frame::Type::RR, true, 0x02));
+  REQUIRE(status.get_type() == Frame::Type::RR);
+  REQUIRE(status.get_recieve_sequence() == 0);
+  std::vector<int> requested;
+  Frame            srej;
+  while (link.a.recieve_frame(srej))
+  {
+    REQUIRE(srej.get_type() == Frame::Type::SREJ);
+    REQUIRE(srej.is_final() == false);
+    requested.push_back(srej.get_recieve_sequence());
+    if (requested.size() == 2)
+      break;
+  }
+  REQUIRE(requested == std::vector<int>{0, 2});
+
+  // Filling the first gap releases 1, filling the second releases 3.
+  handle(information(0, false));
+  REQUIRE(delivered == std::vector<int>{0, 1});
+  const auto final = handle(information(2, true));
+  REQUIRE(delivered == std::vector<int>{0, 1, 2, 3});
+  REQUIRE(final.get_type() == Frame::Type::RR);
+  REQUIRE(final.get_recieve_sequence() == 4);
+
+  // A repeat of a delivered frame is not held.
+  handle(information(3, false));
+  handle(information(4, false));
+  REQUIRE(delivered == std::vector<int>{0, 1, 2, 3, 4});
+}
+
+TEST_CASE("Flow control")
+{
+  snrm_link s;
+
+  SECTION("Byte count follows the FCS.")
+  {
+    // Header and FCS are counted twice, as if every byte was escaped.
+    const std::vector<uint8_t> payload(100, 0x55);
+    REQUIRE(window_probe::frame_bytes<FrameSerializer32>(payload) - window_probe::frame_bytes<FrameSerializer>(payload) == 2 * (fcs32::size - fcs16::size));
+  }
+
+  SECTION("Slow client is not overrun.")
+  {
+    // A window of these is more than the client's in pipe holds.
+    std::vector<std::vector<uint8_t>> sent;
+    for (size_t i = 0; i < 30; ++i) sent.emplace_back(1000, static_cast<uint8_t>(i));
+    s.consumer = [](const Frame&) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      return StatusError::Success;
+    };
+    s.master.set_window_bytes(4096 - 64);
+    REQUIRE(s.master.connect() == StatusError::Success);
+    for (const auto& payload : sent)
+    {
+      REQUIRE(s.master.queue_payload(payload) == StatusError::Success);
+      REQUIRE(s.master.outstanding_bytes() <= s.master.window_bytes());
+    }
+    REQUIRE(s.master.flush() == StatusError::Success);
+    REQUIRE(s.master.outstanding_bytes() == 0);
+    REQUIRE(s.payloads() == sent);
+    REQUIRE(s.information == sent.size());
+    REQUIRE(s.link.dropped() == 0);
+  }
+
+  SECTION("Consumer falls behind.")
+  {
+    const auto sent  = numbered_payloads(50);
+    auto       calls = std::make_shared<size_t>(0);
+    s.consumer       = [calls](const Frame&) { return ((*calls)++ % 7 == 3) ? StatusError::Busy : StatusError::Success; };
+    REQUIRE(s.master.connect() == StatusError::Success);
+    for (const auto& payload : sent) REQUIRE(s.master.queue_payload(payload) == StatusError::Success);
+    REQUIRE(s.master.flush() == StatusError::Success);
+    REQUIRE(s.payloads() == sent);
+    REQUIRE(s.not_ready > 0);
+    REQUIRE(s.master.remote_busy() == false);
+  }
+
+  SECTION("Local busy.")
+  {
+    const auto sent = numbered_payloads(20);
+    REQUIRE(s.master.connect() == StatusError::Success);
+    s.client.set_busy(true);
+    std::thread ready([&s] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      s.client.set_busy(false);
+    });
+    for (const auto& payload : sent) REQUIRE(s.master.queue_payload(payload) == StatusError::Success);
+    REQUIRE(s.master.flush() == StatusError::Success);
+    ready.join();
+    REQUIRE(s.payloads() == sent);
+    REQUIRE(s.not_ready > 0);
+  }
+
+  SECTION("Lost response is not repeated.")
+  {
+    s.echo          = true;
+    s.drop_response = snrm_link::drop_nth(0, [](const Frame& f) { return f.is_information(); });
+    s.link.a.set_response_timeout(100);
+    REQUIRE(s.master.connect() == StatusError::Success);
+    const auto           sent = numbered_payloads(5);
+    std::vector<uint8_t> response;
+    REQUIRE(s.master.send_payload(sent[0], response) == StatusError::Success);
+    REQUIRE(response.empty());
+    for (size_t i = 1; i < sent.size(); ++i)
+    {
+      REQUIRE(s.master.send_payload(sent[i], response) == StatusError::Success);
+      REQUIRE(response == sent[i]);
+    }
+  }
+}
+
+TEST_CASE("Sequence checks")
+{
+  link_io link;
+
+  SECTION("Client.")
+  {
+    session::snrm::Client<link_io::endpoint> client(link.b, 0x02, 0x01);
+    Frame                                    resp(Frame::Type::UNSET);
+    REQUIRE(client.handle(Frame(Frame::Type::SNRM, true, 0x02), resp) == StatusError::Success);
+    REQUIRE(client.handle(Frame(Frame::Type::RR, true, 0x02, 0), resp) == StatusError::Success);
+    // Nothing was sent which N(R) 3 could acknowledge.
+    REQUIRE(client.handle(Frame(Frame::Type::RR, true, 0x02, 3), resp) == StatusError::InvalidSequence);
+    REQUIRE(client.handle(Frame(std::vector<uint8_t>{1}, Frame::Type::I, true, 0x02, 3, 0), resp) == StatusError::InvalidSequence);
+  }
+
+  SECTION("Master.")
+  {
+    session::snrm::Master<link_io::endpoint> master(link.a, 0x01, 0x02);
+    bool                                     got_snrm = false; // Catch assertions only run on the test thread.
+    std::thread                              client([&link, &got_snrm] {
+      // Accept the link, then acknowledge a frame which was never sent.
+      Frame cmd;
+      got_snrm = link.b.recieve_frame(cmd) && cmd.get_type() == Frame::Type::SNRM;
+      link.b.send_frame(Frame(Frame::Type::UA, true, 0x01));
+      while (link.b.recieve_frame(cmd) && !cmd.is_poll())
+      {
+      }
+      link.b.send_frame(Frame(Frame::Type::RR, true, 0x01, 5));
+    });
+    const auto sent      = numbered_payloads(2);
+    const auto connected = master.connect();
+    const auto queued    = master.queue_payload(sent[0]);
+    const auto flushed   = master.flush();
+    client.join();
+    REQUIRE(got_snrm);
+    REQUIRE(connected == StatusError::Success);
+    REQUIRE(queued == StatusError::Success);
+    REQUIRE(flushed == StatusError::InvalidSequence);
+    REQUIRE(master.connected() == false);
+  }
+
+  SECTION("Stop and wait reports the cause.")
+  {
+    session::snrm::Master<link_io::endpoint> master(link.a, 0x01, 0x02);
+    link.a.set_response_timeout(20);
+    bool        got_snrm = false;
+    std::thread client([&link, &got_snrm] {
+      Frame cmd;
+      got_snrm = link.b.recieve_frame(cmd) && cmd.get_type() == Frame::Type::SNRM;
+      link.b.send_frame(Frame(Frame::Type::UA, true, 0x01));
+      // The first payload goes unanswered until the master sets the link
+      // up again, the next is acknowledged beyond what was sent.
+      while (link.b.recieve_frame(cmd) && cmd.get_type() != Frame::Type::SNRM)
+      {
+      }
+      link.b.send_frame(Frame(Frame::Type::UA, true, 0x01));
+      while (link.b.recieve_frame(cmd) && !cmd.is_information())
+      {
+      }
+      link.b.send_frame(Frame(Frame::Type::RR, true, 0x01, 5));
+    });
+    const auto sent       = numbered_payloads(2);
+    const auto connected  = master.connect();
+    const auto silent     = master.send_payload(sent[0]);
+    const auto reconnect  = master.connect();
+    const auto misbehaved = master.send_payload(sent[1]);
+    client.join();
+    REQUIRE(got_snrm);
+    REQUIRE(connected == StatusError::Success);
+    REQUIRE(silent == StatusError::NoResponse);
+    REQUIRE(reconnect == StatusError::Success);
+    REQUIRE(misbehaved == StatusError::InvalidSequence);
+    REQUIRE(master.connected() == false);
+  }
+}
+
+namespace
+{
+/**
+ * @brief      Two peers in balanced mode, each runs on its own thread and
+ *             keeps the payloads it receives.
+ */
+template <typename io_t>
+struct abm_pair
+{
+  using peer_type = session::abm::Peer<io_t>;
+
+  abm_pair(io_t& io_a, io_t& io_b) : a(io_a, 0x01, 0x02), b(io_b, 0x02, 0x01)
+  {
+    // Short timeouts so lost frames are noticed quickly.
+    io_a.set_response_timeout(10);
+    io_b.set_response_timeout(10);
+    a.set_retransmit_timeout(100);
+    b.set_retransmit_timeout(100);
+    a.set_information_handler([this](const Frame& f) { to_a.emplace_back(f.begin(), f.end()); });
+    b.set_information_handler([this](const Frame& f) { to_b.emplace_back(f.begin(), f.end()); });
+    t_a = std::thread([this] {
+      while (!done) a.run();
+    });
+    t_b = std::thread([this] {
+      while (!done) b.run();
+    });
+  }
+  ~abm_pair() { stop(); }
+
+  /**
+   * @brief      Stops both threads, the payloads may be read after.
+   */
+  void stop(void)
+  {
+    done = true;
+    if (t_a.joinable())
+      t_a.join();
+    if (t_b.joinable())
+      t_b.join();
+  }
+
+  /**
+   * @return     Number of payloads which could not be sent.
+   */
+  static size_t send_all(peer_type& peer, const std::vector<std::vector<uint8_t>>& payloads)
+  {
+    size_t failed = 0;
+    for (const auto& payload : payloads) failed += peer.send_payload(payload) != StatusError::Success;
+    return failed + (peer.flush() != StatusError::Success);
+  }
+
+  peer_type                         a;
+  peer_type                         b;
+  std::vector<std::vector<uint8_t>> to_a; //! Received by a.
+  std::vector<std::vector<uint8_t>> to_b; //! Received by b.
+  std::atomic<bool>                 done{false};
+  std::thread                       t_a;
+  std::thread                       t_b;
+};
+
+template <typename pair_t>
+void exchange_both_ways(pair_t& p, const std::vector<std::vector<uint8_t>>& sent)
+{
+  size_t      failed_b = 0;
+  std::thread sender([&] { failed_b = pair_t::send_all(p.b, sent); });
+  REQUIRE(pair_t::send_all(p.a, sent) == 0);
+  sender.join();
+  REQUIRE(failed_b == 0);
+  p.stop();
+  REQUIRE(p.to_a == sent);
+  REQUIRE(p.to_b == sent);
+}
+} // namespace
+
+TEST_CASE("Balanced mode")
+{
+  link_io                     link;
+  abm_pair<link_io::endpoint> p(link.a, link.b);
+  const auto                  sent = numbered_payloads(100);
+
+  // Counts what crosses the link and drops frames matching drop.
+  std::atomic<size_t> information{0}, supervisory{0};
+  const auto          hook = [&](std::function<bool(const Frame&)> drop) {
+    return [&information, &supervisory, drop](std::vector<uint8_t>& bytes) {
+      const auto frame = FrameSerializer::decode(span<const uint8_t>(bytes));
+      information += frame.is_information();
+      supervisory += frame.is_supervisory();
+      return !(drop && drop(frame));
+    };
+  };
+
+  SECTION("Connect from either end.")
+  {
+    REQUIRE(p.b.connect() == StatusError::Success);
+    REQUIRE(p.b.connected());
+    // The other end is connected once it has answered.
+    REQUIRE(p.a.connected());
+    REQUIRE(p.a.connect() == StatusError::Success);
+  }
+
+  SECTION("Both directions at once.")
+  {
+    link.set_tamper(hook(nullptr), hook(nullptr));
+    REQUIRE(p.a.connect() == StatusError::Success);
+    exchange_both_ways(p, sent);
+    REQUIRE(information == 2 * sent.size());
+    // Most acknowledgements ride on information frames.
+    REQUIRE(supervisory < information);
+  }
+
+  SECTION("Lost frames are repeated.")
+  {
+    link.set_tamper(hook(snrm_link::drop_nth(5, [](const Frame& f) { return f.is_information(); })),
+                    hook(snrm_link::drop_nth(17, [](const Frame& f) { return f.is_information(); })));
+    REQUIRE(p.a.connect() == StatusError::Success);
+    exchange_both_ways(p, sent);
+    REQUIRE(information > 2 * sent.size());
+  }
+
+  SECTION("Lost last frame.")
+  {
+    // Nothing follows it to show the gap, the timer finds it.
+    link.set_tamper(hook(snrm_link::drop_nth(9, [](const Frame& f) { return f.is_information(); })), hook(nullptr));
+    REQUIRE(p.a.connect() == StatusError::Success);
+    const auto ten = numbered_payloads(10);
+    REQUIRE(abm_pair<link_io::endpoint>::send_all(p.a, ten) == 0);
+    p.stop();
+    REQUIRE(p.to_b == ten);
+  }
+
+  SECTION("Lost acknowledgements.")
+  {
+    link.set_tamper(hook(nullptr), hook([](const Frame& f) { return f.is_supervisory() && !f.is_final(); }));
+    REQUIRE(p.a.connect() == StatusError::Success);
+    const auto ten = numbered_payloads(10);
+    REQUIRE(abm_pair<link_io::endpoint>::send_all(p.a, ten) == 0);
+    p.stop();
+    REQUIRE(p.to_b == ten);
+  }
+
+  SECTION("Invalid N(R) drops the link.")
+  {
+    link.set_tamper(hook(nullptr), [](std::vector<uint8_t>& bytes) {
+      auto frame = FrameSerializer::decode(span<const uint8_t>(bytes));
+      if (frame.is_supervisory())
+      {
+        frame.set_recieve_sequence(frame.get_recieve_sequence() + 3);
+        bytes = FrameSerializer::escape(FrameSerializer::serialize(frame));
+      }
+      return true;
+    });
+    REQUIRE(p.a.connect() == StatusError::Success);
+    REQUIRE(p.a.queue_payload(sent[0]) == StatusError::Success);
+    REQUIRE(p.a.flush() == StatusError::ConnectionError);
+    REQUIRE(p.a.connected() == false);
+  }
+
+  SECTION("Frame sent after a poll is not repeated.")
+  {
+    // The poll and the answer take a while, the second frame is sent
+    // while they are on their way. Acknowledgements other than the answer
+    // to a poll are lost, so a polls once the first frame times out.
+    link_io                     slow(std::chrono::milliseconds(20));
+    abm_pair<link_io::endpoint> q(slow.a, slow.b);
+    std::atomic<bool>           polled{false};
+    std::atomic<size_t>         second{0};
+    slow.set_tamper(
+        [&polled, &second](std::vector<uint8_t>& bytes) {
+          const auto frame = FrameSerializer::decode(span<const uint8_t>(bytes));
+          polled           = polled || (frame.is_supervisory() && frame.is_poll());
+          second += frame.is_information() && frame.get_send_sequence() == 1;
+          return true;
+        },
+        [](std::vector<uint8_t>& bytes) {
+          const auto frame = FrameSerializer::decode(span<const uint8_t>(bytes));
+          return !(frame.is_supervisory() && !frame.is_final());
+        });
+
+    REQUIRE(q.a.connect() == StatusError::Success);
+    REQUIRE(q.a.queue_payload(sent[0]) == StatusError::Success);
+    const auto start = std::chrono::steady_clock::now();
+    while (!polled && std::chrono::steady_clock::now() - start < std::chrono::seconds(1)) std::this_thread::yield();
+    REQUIRE(polled);
+    REQUIRE(q.a.queue_payload(sent[1]) == StatusError::Success);
+    REQUIRE(q.a.flush() == StatusError::Success);
+    q.stop();
+    REQUIRE(second == 1);
+    REQUIRE(q.to_b == std::vector<std::vector<uint8_t>>{sent[0], sent[1]});
+  }
+
+  SECTION("Byte window.")
+  {
+    // The first frame is still on its way when the second is queued.
+    link_io                     slow(std::chrono::milliseconds(20));
+    abm_pair<link_io::endpoint> q(slow.a, slow.b);
+    q.a.set_window_bytes(1);
+    REQUIRE(q.a.connect() == StatusError::Success);
+    REQUIRE(q.a.queue_payload(sent[0]) == StatusError::Success);
+    REQUIRE(q.a.queue_payload(sent[1]) == StatusError::Busy);
+    REQUIRE(q.a.send_payload(sent[1]) == StatusError::Success);
+    REQUIRE(q.a.flush() == StatusError::Success);
+    q.stop();
+    REQUIRE(q.to_b == std::vector<std::vector<uint8_t>>{sent[0], sent[1]});
+  }
+
+  SECTION("Full out pipe.")
+  {
+    // The link stalls and the out pipe of a fills up, calls still return
+    // at once and the frames left over go once it drains.
+    std::atomic<bool> hold{false};
+    const auto        stall = [&hold](std::vector<uint8_t>&) {
+      while (hold) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return true;
+    };
+    link.set_tamper(stall, stall);
+    REQUIRE(p.a.connect() == StatusError::Success);
+
+    std::vector<std::vector<uint8_t>> large(7, std::vector<uint8_t>(1000));
+    for (size_t i = 0; i < large.size(); ++i) large[i][0] = static_cast<uint8_t>(i);
+    hold              = true;
+    const auto start  = std::chrono::steady_clock::now();
+    size_t     failed = 0;
+    for (const auto& payload : large) failed += p.a.queue_payload(payload) != StatusError::Success;
+    const auto outstanding = p.a.outstanding();
+    const auto elapsed     = std::chrono::steady_clock::now() - start;
+    hold                   = false;
+
+    REQUIRE(failed == 0);
+    REQUIRE(outstanding == large.size());
+    REQUIRE(elapsed < std::chrono::milliseconds(50));
+    REQUIRE(p.a.flush() == StatusError::Success);
+    p.stop();
+    REQUIRE(p.to_b == large);
+  }
+
+  SECTION("Frame arriving across idle timeouts.")
+  {
+    REQUIRE(p.a.connect() == StatusError::Success);
+    // A slow line, half the frame arrives a few response timeouts before
+    // the rest and the peer must keep it.
+    const auto bytes = FrameSerializer::escape(FrameSerializer::serialize(Frame(sent[0], Frame::Type::I, false, p.b.local(), 0, 0)));
+    const auto half  = bytes.size() / 2;
+    link.b.in_bytes(span<const uint8_t>(bytes.data(), half));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    link.b.in_bytes(span<const uint8_t>(bytes.data() + half, bytes.size() - half));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    p.stop();
+    REQUIRE(p.to_b == std::vector<std::vector<uint8_t>>{sent[0]});
+  }
+
+  SECTION("Disconnect.")
+  {
+    REQUIRE(p.a.connect() == StatusError::Success);
+    p.a.close();
+    REQUIRE(p.a.queue_payload(sent[0]) == StatusError::ConnectionError);
+    const auto start = std::chrono::steady_clock::now();
+    while (p.b.connected() && std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    REQUIRE(p.b.connected() == false);
+  }
+
+#if HDLC_USE_EPOLL
+  SECTION("Socket pair.")
+  {
+    int sv[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    reactor r;
+    fd_io   io_a(sv[0], 4096), io_b(sv[1], 4096);
+    REQUIRE(r.add(io_a));
+    REQUIRE(r.add(io_b));
+    std::thread t_reactor([&r] { r.run(); });
+    {
+      abm_pair<fd_io> q(io_a, io_b);
+      REQUIRE(q.a.connect() == StatusError::Success);
+      std::vector<std::vector<uint8_t>> large;
+      for (size_t i = 0; i < 200; ++i) large.emplace_back(256, static_cast<uint8_t>(i));
+      exchange_both_ways(q, large);
+    }
+    r.stop();
+    t_reactor.join();
+    ::close(sv[0]);
+    ::close(sv[1]);
+  }
+#endif
+}
+
+TEST_CASE("Extended mode")
+{
+  const auto sent = numbered_payloads(300);
+
+  SECTION("Window of 127.")
+  {
+    snrm_link s;
+    s.master.set_extended(true);
+    REQUIRE(s.master.connect() == StatusError::Success);
+    REQUIRE(s.master.control_field() == ControlField::Extended);
+    REQUIRE(s.client.control_field() == ControlField::Extended);
+    s.master.set_window(200);
+    REQUIRE(s.master.window() == 127);
+
+    size_t most = 0;
+    for (const auto& payload : sent)
+    {
+      REQUIRE(s.master.queue_payload(payload) == StatusError::Success);
+      most = std::max(most, s.master.outstanding());
+    }
+    REQUIRE(most > 7);
+    REQUIRE(most <= 127);
+    REQUIRE(s.master.flush() == StatusError::Success);
+    REQUIRE(s.payloads() == sent);
+    REQUIRE(s.information == sent.size());
+  }
+
+  SECTION("Lost frames are repeated.")
+  {
+    snrm_link s;
+    s.drop_command = snrm_link::drop_nth(150, [](const Frame& f) { return f.is_information() && !f.is_poll(); });
+    s.master.set_extended(true);
+    REQUIRE(s.master.connect() == StatusError::Success);
+    for (const auto& payload : sent) REQUIRE(s.master.queue_payload(payload) == StatusError::Success);
+    REQUIRE(s.master.flush() == StatusError::Success);
+    REQUIRE(s.payloads() == sent);
+    REQUIRE(s.information > sent.size());
+  }
+
+  SECTION("Selective reject with half the sequence space.")
+  {
+    snrm_link s;
+    s.client.set_selective_reject(true);
+    s.drop_command = snrm_link::drop_nth(100, [](const Frame& f) { return f.is_information() && !f.is_poll(); });
+    s.master.set_extended(true);
+    REQUIRE(s.master.connect() == StatusError::Success);
+    s.master.set_window(64);
+    for (const auto& payload : sent) REQUIRE(s.master.queue_payload(payload) == StatusError::Success);
+    REQUIRE(s.master.flush() == StatusError::Success);
+    REQUIRE(s.payloads() == sent);
+    REQUIRE(s.selective > 0);
+    // Only the lost frame is sent again.
+    REQUIRE(s.information == sent.size() + 1);
+  }
+
+  SECTION("SNRM goes back to the basic field.")
+  {
+    snrm_link s;
+    s.master.set_extended(true);
+    REQUIRE(s.master.connect() == StatusError::Success);
+    s.master.disconnect();
+    s.master.set_extended(false);
+    REQUIRE(s.master.connect() == StatusError::Success);
+    REQUIRE(s.master.control_field() == ControlField::Basic);
+    REQUIRE(s.master.window() == 7);
+    const auto twenty = numbered_payloads(20);
+    for (const auto& payload : twenty) REQUIRE(s.master.queue_payload(payload) == StatusError::Success);
+    REQUIRE(s.master.flush() == StatusError::Success);
+    REQUIRE(s.payloads() == twenty);
+    REQUIRE(s.client.control_field() == ControlField::Basic);
+  }
+
+  SECTION("Balanced mode.")
+  {
+    link_io                     link;
+    abm_pair<link_io::endpoint> p(link.a, link.b);
+    p.a.set_extended(true);
+    p.a.set_window(127);
+    p.b.set_window(127);
+    REQUIRE(p.a.connect() == StatusError::Success);
+    REQUIRE(p.a.control_field() == ControlField::Extended);
+    REQUIRE(p.b.control_field() == ControlField::Extended);
+    exchange_both_ways(p, sent);
+  }
+}
+
+#if HDLC_USE_EPOLL || HDLC_USE_IO_URING
+namespace
+{
+size_t thread_count(void)
+{
+  size_t count = 0;
+  if (auto dir = opendir("/proc/self/task"))
+  {
+    while (auto entry = readdir(dir))
+      count += entry->d_name[0] != '.';
+    closedir(dir);
+  }
+  return count;
+}
+
+/**
+ * @brief      Links constructed in place, the pipes are over aligned so they
+ *             cannot be allocated with new before C++17.
+ */
+template <size_t count, typename link_t>
+struct fd_links
+{
+  fd_links(const int* fds) : fd_links(fds, std::make_index_sequence<count>()) {}
+  template <size_t... index>
+  fd_links(const int* fds, std::index_sequence<index...>) : links{{{fds[index]}...}}
+  {
+  }
+
+  std::array<link_t, count> links;
+};
+} // namespace
+#endif
+
+#if HDLC_USE_EPOLL
+TEST_CASE("Reactor")
+{
+  reactor r;
+  REQUIRE(r.is_open());
+  std::thread t_reactor;
+
+  // Stops the reactor thread if a section fails before doing so itself.
+  struct stopper
+  {
+    reactor&     r;
+    std::thread& t;
+    ~stopper()
+    {
+      if (t.joinable())
+      {
+        r.stop();
+        t.join();
+      }
+    }
+  } stop_on_exit{r, t_reactor};
+
+  SECTION("Socket pair.")
+  {
+    int sv[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    {
+      fd_io a(sv[0]), b(sv[1]);
+      REQUIRE(r.add(a));
+      REQUIRE(r.add(b));
+      REQUIRE(r.size() == 2);
+      t_reactor = std::thread([&r] { r.run(); });
+
+      for (auto i = TEST_REPEAT_LOW; i--;)
+      {
+        const auto f1 = RandomFrameFactory::make_inforamtion(a.max_send_size() >> 1);
+        const auto f2 = RandomFrameFactory::make_inforamtion(b.max_send_size() >> 1);
+        Frame      rx;
+
+        REQUIRE(a.send_frame(f1));
+        REQUIRE(b.recieve_frame(rx));
+        REQUIRE(rx == f1);
+        REQUIRE(b.send_frame(f2));
+        REQUIRE(a.recieve_frame(rx));
+        REQUIRE(rx == f2);
+      }
+
+      r.stop();
+      t_reactor.join();
+    }
+    ::close(sv[0]);
+    ::close(sv[1]);
+  }
+
+  SECTION("Many links on one thread.")
+  {
+    constexpr size_t    pairs   = 16;
+    const auto          threads = thread_count() + 1; // The reactor thread.
+    std::array<int, 32> fds;
+    for (size_t i = 0; i < pairs; ++i) REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, &fds[2 * i]) == 0);
+
+    fd_links<2 * pairs, fd_io> set(fds.data());
+    auto&                      links = set.links;
+
+    std::atomic<size_t> received(0);
+    for (auto& link : links)
+    {
+      link.on_frame([&received](const FrameView& view) {
+        if (view.payload_size() == 100)
+          ++received;
+      });
+      REQUIRE(r.add(link));
+    }
+    t_reactor = std::thread([&r] { r.run(); });
+
+    const Frame f1(std::vector<uint8_t>(100, 0x7E), Frame::Type::I);
+    for (auto& link : links) REQUIRE(link.send_frame(f1));
+
+    const auto start = std::chrono::steady_clock::now();
+    while (received.load() < links.size() && std::chrono::steady_clock::now() - start < std::chrono::seconds(1))
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    REQUIRE(received.load() == links.size());
+    REQUIRE(thread_count() == threads);
+
+    r.stop();
+    t_reactor.join();
+    for (auto& link : links) r.remove(link);
+    for (auto fd : fds) ::close(fd);
+  }
+
+  SECTION("Writes resume when the descriptor drains.")
+  {
+    int sv[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    const int small = 4096;
+    ::setsockopt(sv[0], SOL_SOCKET, SO_SNDBUF, &small, sizeof(small));
+    ::setsockopt(sv[1], SOL_SOCKET, SO_RCVBUF, &small, sizeof(small));
+    {
+      fd_io a(sv[0], 8192), b(sv[1], 8192);
+      REQUIRE(r.add(a));
+      REQUIRE(r.add(b));
+      t_reactor = std::thread([&r] { r.run(); });
+
+      // Far more than the socket buffers hold, the sender is throttled by
+      // the out pipe and the reactor waits for EPOLLOUT in between.
+      constexpr size_t frames = 200;
+      std::vector<Frame> sent;
+      for (size_t i = 0; i < frames; ++i) sent.push_back(RandomFrameFactory::make_inforamtion(300));
+
+      std::thread sender([&] {
+        for (const auto& f : sent)
+        {
+          while (a.send_frame(f) == false) std::this_thread::yield();
+        }
+      });
+
+      size_t matched = 0;
+      for (size_t i = 0; i < frames; ++i)
+      {
+        Frame rx;
+        if (b.recieve_frame(rx) && rx == sent[i])
+          ++matched;
+      }
+      sender.join();
+      REQUIRE(matched == frames);
+
+      r.stop();
+      t_reactor.join();
+    }
+    ::close(sv[0]);
+    ::close(sv[1]);
+  }
+
+  SECTION("Full in pipe stalls the link.")
+  {
+    int sv[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    {
+      // Nothing consumes from a until the end, so its small in pipe fills
+      // while the socket still has bytes to read.
+      fd_io a(sv[0], 64), b(sv[1]);
+      REQUIRE(r.add(a));
+      REQUIRE(r.add(b));
+
+      constexpr size_t frames = 20;
+      std::vector<Frame> sent;
+      for (size_t i = 0; i < frames; ++i)
+      {
+        sent.push_back(RandomFrameFactory::make_inforamtion(16));
+        REQUIRE(b.send_frame(sent.back()));
+      }
+
+      // Once stalled every wake up is a retry timeout, a readable descriptor
+      // left in the set would return at once and spin instead.
+      size_t     wakeups = 0;
+      const auto start   = std::chrono::steady_clock::now();
+      while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(100))
+      {
+        r.run_once(-1);
+        ++wakeups;
+      }
+      REQUIRE(a.in_full());
+      REQUIRE(wakeups <= 100 / reactor::stall_retry_ms + 5);
+
+      // Draining the pipe resumes reading the rest.
+      t_reactor = std::thread([&r] { r.run(); });
+      size_t matched = 0;
+      for (size_t i = 0; i < frames; ++i)
+      {
+        Frame rx;
+        if (a.recieve_frame(rx) && rx == sent[i])
+          ++matched;
+      }
+      REQUIRE(matched == frames);
+
+      r.stop();
+      t_reactor.join();
+    }
+    ::close(sv[0]);
+    ::close(sv[1]);
+  }
+
+  SECTION("Closed link with output pending.")
+  {
+    int sv[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    {
+      const int small = 4096;
+      ::setsockopt(sv[0], SOL_SOCKET, SO_SNDBUF, &small, sizeof(small));
+      ::setsockopt(sv[1], SOL_SOCKET, SO_RCVBUF, &small, sizeof(small));
+      fd_io a(sv[0], 65536);
+      REQUIRE(r.add(a));
+      // The end of file is seen first and removes the link. The output
+      // signalled after it is in the same batch and more than the socket
+      // takes, waiting for EPOLLOUT must not put the descriptor back.
+      REQUIRE(::shutdown(sv[1], SHUT_WR) == 0);
+      for (auto i = 10; i--;) REQUIRE(a.send_frame(RandomFrameFactory::make_inforamtion(4096)));
+      r.run_once(0);
+      REQUIRE(r.size() == 0);
+
+      // Adding fails if the descriptor was still in the epoll set.
+      REQUIRE(r.add(a));
+      REQUIRE(r.remove(a));
+    }
+    ::close(sv[0]);
+    ::close(sv[1]);
+  }
+
+  SECTION("Pseudo terminal.")
+  {
+    const int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+    REQUIRE(master >= 0);
+    REQUIRE(::grantpt(master) == 0);
+    REQUIRE(::unlockpt(master) == 0);
+    const int slave = ::open(::ptsname(master), O_RDWR | O_NOCTTY);
+    REQUIRE(slave >= 0);
+
+    // Raw mode, otherwise the line discipline rewrites the bytes.
+    termios tio;
+    REQUIRE(::tcgetattr(slave, &tio) == 0);
+    ::cfmakeraw(&tio);
+    REQUIRE(::tcsetattr(slave, TCSANOW, &tio) == 0);
+    {
+      fd_io a(master), b(slave);
+      REQUIRE(r.add(a));
+      REQUIRE(r.add(b));
+      t_reactor = std::thread([&r] { r.run(); });
+
+      for (auto i = TEST_REPEAT_LOW; i--;)
+      {
+        const auto f1 = RandomFrameFactory::make_inforamtion(a.max_send_size() >> 1);
+        Frame      rx;
+        REQUIRE(a.send_frame(f1));
+        REQUIRE(b.recieve_frame(rx));
+        REQUIRE(rx == f1);
+        REQUIRE(b.send_frame(f1));
+        REQUIRE(a.recieve_frame(rx));
+        REQUIRE(rx == f1);
+      }
+
+      r.stop();
+      t_reactor.join();
+    }
+    ::close(slave);
+    ::close(master);
+  }
+}
+#endif
+
+#if HDLC_USE_EPOLL
+TEST_CASE("Tty")
+{
+  const int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+  REQUIRE(master >= 0);
+  REQUIRE(::grantpt(master) == 0);
+  REQUIRE(::unlockpt(master) == 0);
+  const std::string path = ::ptsname(master);
+
+  // The pty master stands in for the device on the other end of the cable.
+  fd_io           remote(master, 4096);
+  tty::settings   s;
+  s.baud = 921600;
+
+  SECTION("Configuration.")
+  {
+    s.baud = 12345;
+    tty_io bad_rate(path.c_str(), s);
+    REQUIRE_FALSE(bad_rate.is_open());
+
+    tty_io missing("/dev/hdlc-missing-tty");
+    REQUIRE_FALSE(missing.is_open());
+
+    s.baud = 921600;
+    tty_io port(path.c_str(), s);
+    REQUIRE(port.is_open());
+
+    termios tio;
+    REQUIRE(::tcgetattr(port.native_handle(), &tio) == 0);
+    REQUIRE(::cfgetospeed(&tio) == B921600);
+    REQUIRE((tio.c_lflag & (ICANON | ECHO | ISIG)) == 0);
+    REQUIRE((tio.c_oflag & OPOST) == 0);
+    REQUIRE((tio.c_cflag & CSIZE) == CS8);
+    REQUIRE((tio.c_cflag & CLOCAL) == CLOCAL);
+    REQUIRE((::fcntl(port.native_handle(), F_GETFL) & O_NONBLOCK) == O_NONBLOCK);
+
+    // A pty has no serial driver behind it.
+    REQUIRE_FALSE(tty::set_low_latency(port.native_handle(), true));
+  }
+
+  SECTION("Reactor.")
+  {
+    reactor r;
+    tty_io  port(path.c_str(), s);
+    REQUIRE(port.is_open());
+    REQUIRE(r.add(port));
+    REQUIRE(r.add(remote));
+    std::thread t_reactor([&r] { r.run(); });
+
+    size_t matched = 0;
+    for (auto i = TEST_REPEAT_LOW; i--;)
+    {
+      const auto f1 = RandomFrameFactory::make_inforamtion(1000);
+      Frame      rx;
+      if (port.send_frame(f1) && remote.recieve_frame(rx) && rx == f1 && remote.send_frame(f1) && port.recieve_frame(rx) && rx == f1)
+        ++matched;
+    }
+
+    r.stop();
+    t_reactor.join();
+    REQUIRE(matched == TEST_REPEAT_LOW);
+  }
+
+  SECTION("Blocking reads.")
+  {
+    s.non_blocking = false;
+    tty_io port(path.c_str(), s);
+    REQUIRE(port.is_open());
+    REQUIRE((::fcntl(port.native_handle(), F_GETFL) & O_NONBLOCK) == 0);
+
+    for (auto i = TEST_REPEAT_LOW; i--;)
+    {
+      const auto f1 = RandomFrameFactory::make_inforamtion(1000);
+      Frame      rx;
+
+      // handle_in() returns once VMIN bytes arrived or the line idled for
+      // VTIME, a frame may take more than one chunk.
+      REQUIRE(remote.send_frame(f1));
+      REQUIRE(remote.handle_out());
+      while (port.in_frame_count() == 0) REQUIRE(port.handle_in());
+      REQUIRE(port.recieve_frame(rx));
+      REQUIRE(rx == f1);
+
+      REQUIRE(port.send_frame(f1));
+      REQUIRE(port.handle_out());
+      const auto start = std::chrono::steady_clock::now();
+      while (remote.in_frame_count() == 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds(1)) REQUIRE(remote.handle_in());
+      REQUIRE(remote.recieve_frame(rx));
+      REQUIRE(rx == f1);
+    }
+  }
+
+  ::close(master);
+}
+#endif
+
+#if HDLC_USE_IO_URING
+TEST_CASE("Uring reactor")
+{
+  uring_reactor r;
+  if (!r.is_open())
+  {
+    WARN("io_uring is not available, skipping");
+    return;
+  }
+  std::thread t_reactor;
+
+  struct stopper
+  {
+    uring_reactor& r;
+    std::thread&   t;
+    ~stopper()
+    {
+      if (t.joinable())
+      {
+        r.stop();
+        t.join();
+      }
+    }
+  } stop_on_exit{r, t_reactor};
+
+  SECTION("Socket pair.")
+  {
+    int sv[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    {
+      uring_io a(sv[0]), b(sv[1]);
+      REQUIRE(r.add(a));
+      REQUIRE(r.add(b));
+      REQUIRE(r.size() == 2);
+      t_reactor = std::thread([&r] { r.run(); });
+
+      for (auto i = TEST_REPEAT_LOW; i--;)
+      {
+        const auto f1 = RandomFrameFactory::make_inforamtion(a.max_send_size() >> 1);
+        const auto f2 = RandomFrameFactory::make_inforamtion(b.max_send_size() >> 1);
+        Frame      rx;
+
+        REQUIRE(a.send_frame(f1));
+        REQUIRE(b.recieve_frame(rx));
+        REQUIRE(rx == f1);
+        REQUIRE(b.send_frame(f2));
+        REQUIRE(a.recieve_frame(rx));
+        REQUIRE(rx == f2);
+      }
+
+      r.stop();
+      t_reactor.join();
+      REQUIRE(r.remove(a));
+      REQUIRE(r.remove(b));
+      REQUIRE(r.size() == 0);
+    }
+    ::close(sv[0]);
+    ::close(sv[1]);
+  }
+
+#if HDLC_USE_MIRRORED_RING
+  SECTION("Mirrored pipes.")
+  {
+    // Both copies of the ring are registered, reads and writes cross the
+    // wrap in one request.
+    using mirrored_io = basic_uring_io<fcs16, MirroredFramePipe>;
+    int sv[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    {
+      mirrored_io a(sv[0]), b(sv[1]);
+      REQUIRE(r.add(a));
+      REQUIRE(r.add(b));
+      t_reactor = std::thread([&r] { r.run(); });
+
+      size_t matched = 0;
+      for (auto i = TEST_REPEAT_LOW * 20; i--;)
+      {
+        const auto f1 = RandomFrameFactory::make_inforamtion(a.max_send_size() >> 2);
+        Frame      rx;
+        if (a.send_frame(f1) && b.recieve_frame(rx) && rx == f1 && b.send_frame(f1) && a.recieve_frame(rx) && rx == f1)
+          ++matched;
+      }
+
+      r.stop();
+      t_reactor.join();
+      REQUIRE(matched == TEST_REPEAT_LOW * 20);
+      REQUIRE(r.remove(a));
+      REQUIRE(r.remove(b));
+    }
+    ::close(sv[0]);
+    ::close(sv[1]);
+  }
+#endif
+
+  SECTION("Many links on one thread.")
+  {
+    constexpr size_t    pairs   = 16;
+    const auto          threads = thread_count() + 1; // The reactor thread.
+    std::array<int, 32> fds;
+    for (size_t i = 0; i < pairs; ++i) REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, &fds[2 * i]) == 0);
+
+    fd_links<2 * pairs, uring_io> set(fds.data());
+    auto&                         links = set.links;
+
+    std::atomic<size_t> received(0);
+    for (auto& link : links)
+    {
+      link.on_frame([&received](const FrameView& view) {
+        if (view.payload_size() == 100)
+          ++received;
+      });
+      REQUIRE(r.add(link));
+    }
+    t_reactor = std::thread([&r] { r.run(); });
+
+    const Frame f1(std::vector<uint8_t>(100, 0x7E), Frame::Type::I);
+    for (auto& link : links) REQUIRE(link.send_frame(f1));
+
+    const auto start = std::chrono::steady_clock::now();
+    while (received.load() < links.size() && std::chrono::steady_clock::now() - start < std::chrono::seconds(1))
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    REQUIRE(received.load() == links.size());
+    REQUIRE(thread_count() == threads);
+
+    r.stop();
+    t_reactor.join();
+    for (auto& link : links) REQUIRE(r.remove(link));
+    for (auto fd : fds) ::close(fd);
+  }
+
+  SECTION("Writes resume when the descriptor drains.")
+  {
+    int sv[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    const int small = 4096;
+    ::setsockopt(sv[0], SOL_SOCKET, SO_SNDBUF, &small, sizeof(small));
+    ::setsockopt(sv[1], SOL_SOCKET, SO_RCVBUF, &small, sizeof(small));
+    {
+      uring_io a(sv[0], 8192), b(sv[1], 8192);
+      REQUIRE(r.add(a));
+      REQUIRE(r.add(b));
+      t_reactor = std::thread([&r] { r.run(); });
+
+      constexpr size_t   frames = 200;
+      std::vector<Frame> sent;
+      for (size_t i = 0; i < frames; ++i) sent.push_back(RandomFrameFactory::make_inforamtion(300));
+
+      std::thread sender([&] {
+        for (const auto& f : sent)
+        {
+          while (a.send_frame(f) == false) std::this_thread::yield();
+        }
+      });
+
+      size_t matched = 0;
+      for (size_t i = 0; i < frames; ++i)
+      {
+        Frame rx;
+        if (b.recieve_frame(rx) && rx == sent[i])
+          ++matched;
+      }
+      sender.join();
+      REQUIRE(matched == frames);
+
+      r.stop();
+      t_reactor.join();
+
+      // Submissions are batched, far fewer system calls than frames.
+      REQUIRE(r.get_statistics().enters < 2 * frames);
+      r.remove(a);
+      r.remove(b);
+    }
+    ::close(sv[0]);
+    ::close(sv[1]);
+  }
+
+  SECTION("Closed peer.")
+  {
+    int sv[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    {
+      uring_io a(sv[0]);
+      REQUIRE(r.add(a));
+      REQUIRE(a.is_open());
+      ::close(sv[1]);
+      const auto start = std::chrono::steady_clock::now();
+      while (a.is_open() && std::chrono::steady_clock::now() - start < std::chrono::seconds(1)) r.run_once(10);
+      REQUIRE(a.is_open() == false);
+      REQUIRE(r.remove(a));
     }
+    ::close(sv[0]);
   }
 }
+#endif
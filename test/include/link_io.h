@@ -0,0 +1,146 @@
+/*
+ * @Author: lokraszewski
+ * @Date:   16-10-2026
+ * @Last Modified by:   lokraszewski
+ * @Last Modified time: 16-10-2026
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "hdlc/hdlc.h"
+#include "hdlc/io.h"
+
+namespace hdlc
+{
+
+/**
+ * @author     lokraszewski
+ * @date       16-Oct-2026
+ * @brief      Two io endpoints joined back to back, a frame sent on one
+ *             arrives on the other.
+ *
+ * @details    A thread moves whole frames across, so a test can drop or
+ *             corrupt single frames on the way. An optional latency holds
+ *             every frame back, as a slow radio or a long serial line would.
+ */
+class link_io
+{
+public:
+  using tamper_t = std::function<bool(std::vector<uint8_t>&)>; //! Sees every frame crossing, returns false to drop it.
+
+  class endpoint : public base_io
+  {
+  public:
+    explicit endpoint(const size_t buffer_size = 4096) : base_io(buffer_size) {}
+
+    size_t get_tick(void) const override
+    {
+      auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+      return static_cast<size_t>(now);
+    }
+    bool handle_out(void) override { return true; }
+    bool handle_in(void) override { return true; }
+    void reset(void) override
+    {
+      m_out_pipe.clear();
+      m_in_pipe.clear();
+    }
+    void sleep(const size_t ms) override { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+    std::vector<uint8_t> take_frame(void) { return m_out_pipe.read_frame(); }
+    size_t               queued_frames(void) const { return m_out_pipe.frame_count(); }
+  };
+
+  /**
+   * @param[in]  latency      How long each frame takes to arrive.
+   * @param[in]  buffer_size  Pipe size of both endpoints.
+   */
+  explicit link_io(const std::chrono::microseconds latency = std::chrono::microseconds(0), const size_t buffer_size = 4096)
+      : a(buffer_size), b(buffer_size), m_latency(latency), t_forward([this] { forward(); })
+  {
+  }
+  ~link_io()
+  {
+    m_done = true;
+    t_forward.join();
+  }
+
+  /**
+   * @brief      Sets the hooks for frames from a to b and from b to a.
+   */
+  void set_tamper(tamper_t a_to_b, tamper_t b_to_a)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_a_to_b = std::move(a_to_b);
+    m_b_to_a = std::move(b_to_a);
+  }
+
+  /**
+   * @brief      Bytes which did not fit in the receiving in pipe.
+   */
+  size_t dropped(void) const { return m_dropped; }
+
+  endpoint a;
+  endpoint b;
+
+private:
+  using clock_type = std::chrono::steady_clock;
+
+  struct in_flight
+  {
+    clock_type::time_point due;
+    endpoint*              to;
+    std::vector<uint8_t>   bytes;
+  };
+
+  void forward(void)
+  {
+    std::deque<in_flight> flight;
+    while (!m_done)
+    {
+      const auto now   = clock_type::now();
+      bool       moved = take(a, b, m_a_to_b, now, flight) | take(b, a, m_b_to_a, now, flight);
+      for (; !flight.empty() && flight.front().due <= now; flight.pop_front())
+      {
+        auto& f = flight.front();
+        m_dropped += f.bytes.size() - f.to->in_bytes(span<const uint8_t>(f.bytes));
+        moved = true;
+      }
+      if (!moved)
+        std::this_thread::sleep_for(std::chrono::microseconds(flight.empty() ? 100 : 50));
+    }
+  }
+
+  bool take(endpoint& from, endpoint& to, tamper_t& tamper, const clock_type::time_point now, std::deque<in_flight>& flight)
+  {
+    bool moved = false;
+    while (from.queued_frames())
+    {
+      auto frame = from.take_frame();
+      moved      = true;
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (frame.empty() || (tamper && !tamper(frame)))
+        continue;
+      flight.push_back(in_flight{now + m_latency, &to, std::move(frame)});
+    }
+    return moved;
+  }
+
+  std::mutex                      m_mutex; //! Guards the hooks.
+  tamper_t                        m_a_to_b;
+  tamper_t                        m_b_to_a;
+  const std::chrono::microseconds m_latency; //! Added to every frame, zero passes them on at once.
+  std::atomic<size_t>             m_dropped{0};
+  std::atomic<bool>               m_done{false};
+  std::thread                     t_forward; //! Declared last so everything it uses exists when it starts.
+};
+
+} // namespace hdlc
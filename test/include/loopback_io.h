@@ -14,12 +14,13 @@
 namespace hdlc
 {
 
-class loopback_io : public base_io
+template <typename fcs_t = fcs16, typename pipe_t = FramePipe>
+class basic_loopback_io : public basic_io<fcs_t, pipe_t>
 {
 
 public:
-  loopback_io()
-      : base_io(), t_rx([&]() {
+  basic_loopback_io()
+      : basic_io<fcs_t, pipe_t>(), t_rx([&]() {
           while (!is_done())
           {
             handle_in();
@@ -33,7 +34,7 @@ public:
         })
   {
   }
-  ~loopback_io()
+  ~basic_loopback_io()
   {
     done();
     t_rx.join();
@@ -47,11 +48,18 @@ public:
   }
   bool handle_out(void) override
   {
-    while (m_out_pipe.empty() == false && m_in_pipe.full() == false)
+    // Move to the input pipe in bulk, straight from the out pipe storage.
+    for (;;)
     {
-      // Write to the input pipe.
-      m_in_pipe.write(m_out_pipe.read());
+      const auto data  = this->m_out_pipe.readable_regions();
+      auto       count = this->in_bytes(data.first);
+      if (count == data.first.size())
+        count += this->in_bytes(data.second);
+      if (count == 0)
+        break;
+      this->m_out_pipe.consume(count);
     }
+    this->dispatch_frames();
     return true;
   }
 
@@ -59,17 +67,17 @@ public:
 
   void reset(void) override
   {
-    m_out_pipe.clear();
-    m_in_pipe.clear();
+    this->m_out_pipe.clear();
+    this->m_in_pipe.clear();
   }
 
   void sleep(const size_t ms) override { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
 
 private:
+  mutable std::mutex m_end_of_program_mutex; //! Declared before the threads so it is initialised before they start.
+  bool               m_end_of_program = false;
   std::thread        t_rx;
   std::thread        t_tx;
-  mutable std::mutex m_end_of_program_mutex;
-  bool               m_end_of_program = false;
 
   bool is_done() const
   {
@@ -83,4 +91,7 @@ private:
     m_end_of_program = true;
   }
 };
+
+using loopback_io      = basic_loopback_io<>;
+using spsc_loopback_io = basic_loopback_io<fcs16, SpscFramePipe>; //! Lock free pipes, the test thread and tx thread each own one end.
 } // namespace hdlc